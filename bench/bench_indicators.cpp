@@ -0,0 +1,117 @@
+// Batch indicator micro-benchmark: streaming Indicators vs BatchIndicators
+// (scalar and AVX2 kernels) over one price column.
+//
+// Usage: AlgoCatalystIndicatorBench [values] [reps]
+//   values  length of the price column (default 10,000,000)
+//   reps    timed runs per kernel, best is reported (default 5)
+
+#include "BatchIndicators.h"
+#include "Indicators.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace AlgoCatalyst;
+
+namespace {
+
+struct Column {
+    std::vector<double> high, low, close;
+};
+
+// Deterministic random walk
+Column makeColumn(std::size_t n) {
+    Column c;
+    c.high.resize(n);
+    c.low.resize(n);
+    c.close.resize(n);
+    std::uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    double price = 100.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        price += (static_cast<double>((seed >> 33) % 2001) - 1000.0) * 1e-4;
+        double spread = static_cast<double>((seed >> 20) % 100) * 1e-3;
+        c.close[i] = price;
+        c.high[i] = price + spread;
+        c.low[i] = price - spread;
+    }
+    return c;
+}
+
+// Best wall time of 'reps' runs, in seconds
+double best(std::size_t reps, const std::function<void()>& fn) {
+    double best_s = 1e300;
+    for (std::size_t r = 0; r < reps; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best_s = std::min(best_s, std::chrono::duration<double>(end - start).count());
+    }
+    return best_s;
+}
+
+// Throughput counts the input columns read, 8 bytes per value
+void report(const std::string& name, std::size_t values, std::size_t columns, double seconds, double checksum) {
+    double gbps = static_cast<double>(values * columns * sizeof(double)) / seconds / 1e9;
+    std::cout << std::left << std::setw(26) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(9) << seconds * 1e3 << " ms" << std::setw(9) << gbps << " GB/s"
+              << "   checksum " << std::setprecision(6) << checksum << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::size_t reps = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5;
+    if (n == 0 || reps == 0) {
+        std::cerr << "Usage: " << argv[0] << " [values] [reps]\n";
+        return 1;
+    }
+
+    Column col = makeColumn(n);
+    std::vector<double> a(n), b(n), c(n);
+    std::cout << "Indicator benchmark: " << n << " values, best of " << reps << "\n"
+              << "AVX2 kernels " << (BatchIndicators::simdEnabled() ? "available" : "not available") << "\n\n";
+
+    double last = 0.0;
+    double seconds = best(reps, [&] {
+        Indicators ind;
+        for (double p : col.close) ind.updateEMA(p, 20);
+        last = ind.getEMA(20);
+    });
+    report("streaming EMA(20)", n, 1, seconds, last);
+    seconds = best(reps, [&] {
+        Indicators ind;
+        for (double p : col.close) ind.updateBollingerBands(p, 20, 2.0);
+        last = ind.getBollingerUpper();
+    });
+    report("streaming Bollinger(20)", n, 1, seconds, last);
+    std::cout << "\n";
+
+    bool simd_available = BatchIndicators::simdEnabled();
+    for (bool simd : {false, true}) {
+        if (simd && !simd_available) break;
+        BatchIndicators::setSimdEnabled(simd);
+        std::string suffix = simd ? " avx2" : " scalar";
+
+        seconds = best(reps, [&] { BatchIndicators::ema(col.close, 20, a); });
+        report("EMA(20)" + suffix, n, 1, seconds, a.back());
+        seconds = best(reps, [&] { BatchIndicators::rsi(col.close, 14, a); });
+        report("RSI(14)" + suffix, n, 1, seconds, a.back());
+        seconds = best(reps, [&] { BatchIndicators::atr(col.high, col.low, col.close, 14, a); });
+        report("ATR(14)" + suffix, n, 3, seconds, a.back());
+        seconds = best(reps, [&] { BatchIndicators::macd(col.close, a, b, c); });
+        report("MACD" + suffix, n, 1, seconds, c.back());
+        seconds = best(reps, [&] { BatchIndicators::bollinger(col.close, 20, 2.0, a, b, c); });
+        report("Bollinger(20)" + suffix, n, 1, seconds, a.back());
+        std::cout << "\n";
+    }
+    BatchIndicators::setSimdEnabled(simd_available);
+    return 0;
+}
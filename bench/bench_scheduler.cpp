@@ -0,0 +1,134 @@
+// Scheduler micro-benchmark: std::priority_queue vs BinaryHeapScheduler vs
+// RadixHeapScheduler on an engine-like monotone workload.
+//
+// Usage: AlgoCatalystBench [events] [in_flight]
+//   events     total pops per run (default 10,000,000)
+//   in_flight  steady-state queue depth (default 1,000)
+
+#include "EventStore.h"
+#include "Scheduler.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <vector>
+
+using namespace AlgoCatalyst;
+
+namespace {
+
+// Deterministic LCG so every implementation sees the same key sequence
+struct Lcg {
+    std::uint32_t state = 0x9e3779b9u;
+    std::uint32_t operator()() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+};
+
+// Delay until a follow-up event: like the backtester, most signal -> order hops
+// are immediate (ties), fills land one latency later, a few events are far out
+std::int64_t nextDelay(Lcg& rng) {
+    std::uint32_t r = rng() % 100;
+    if (r < 50) return 0;                                   // Same-timestamp hop
+    if (r < 90) return 200'000;                             // 200 ms fill latency
+    return static_cast<std::int64_t>(rng() % 60'000'000);   // Up to a minute out
+}
+
+struct Later {
+    bool operator()(const ScheduledKey& a, const ScheduledKey& b) const {
+        if (a.timestamp_us != b.timestamp_us) return a.timestamp_us > b.timestamp_us;
+        return a.seq > b.seq;
+    }
+};
+
+// Adapter so std::priority_queue runs through the same driver
+struct PriorityQueueAdapter {
+    std::priority_queue<ScheduledKey, std::vector<ScheduledKey>, Later> q;
+    void push(const ScheduledKey& k) { q.push(k); }
+    ScheduledKey pop() { ScheduledKey k = q.top(); q.pop(); return k; }
+};
+
+struct SchedulerAdapter {
+    Scheduler& s;
+    void push(const ScheduledKey& k) { s.push(k); }
+    ScheduledKey pop() { return s.pop(); }
+};
+
+struct EventStoreAdapter {
+    EventStore& store;
+    void push(const ScheduledKey& k) {
+        EventRecord r{};
+        r.type = EventType::OrderEvent;
+        r.timestamp_us = k.timestamp_us;
+        r.order = {1.0, 100.0, 0.0};
+        store.push(r);
+    }
+    ScheduledKey pop() {
+        EventRecord r = store.pop();
+        return {r.timestamp_us, 0, 0};
+    }
+};
+
+// Hold model: pop the earliest event and schedule one follow-up at or after it
+template <typename Queue>
+double run(Queue& queue, std::size_t events, std::size_t in_flight, std::uint64_t& checksum) {
+    Lcg rng;
+    std::uint64_t seq = 0;
+    for (std::size_t i = 0; i < in_flight; ++i) {
+        queue.push({static_cast<std::int64_t>(rng() % 1'000'000), seq++, 0});
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < events; ++i) {
+        ScheduledKey k = queue.pop();
+        checksum += static_cast<std::uint64_t>(k.timestamp_us);
+        queue.push({k.timestamp_us + nextDelay(rng), seq++, 0});
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / events;
+}
+
+void report(const std::string& name, double ns_per_event, std::uint64_t checksum) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10) << ns_per_event << " ns/event"
+              << "   checksum " << checksum << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t events = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+    std::size_t in_flight = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1'000;
+    if (events == 0 || in_flight == 0) {
+        std::cerr << "Usage: " << argv[0] << " [events] [in_flight]\n";
+        return 1;
+    }
+
+    std::cout << "Scheduler benchmark: " << events << " events, " << in_flight << " in flight\n\n";
+
+    {
+        PriorityQueueAdapter q;
+        std::uint64_t sum = 0;
+        double ns = run(q, events, in_flight, sum);
+        report("std::priority_queue", ns, sum);
+    }
+    for (SchedulerKind kind : {SchedulerKind::BinaryHeap, SchedulerKind::RadixHeap}) {
+        auto scheduler = makeScheduler(kind);
+        SchedulerAdapter q{*scheduler};
+        std::uint64_t sum = 0;
+        double ns = run(q, events, in_flight, sum);
+        report(schedulerName(kind), ns, sum);
+    }
+    for (SchedulerKind kind : {SchedulerKind::BinaryHeap, SchedulerKind::RadixHeap}) {
+        EventStore store(kind);
+        EventStoreAdapter q{store};
+        std::uint64_t sum = 0;
+        double ns = run(q, events, in_flight, sum);
+        report(std::string("EventStore/") + schedulerName(kind), ns, sum);
+    }
+    return 0;
+}
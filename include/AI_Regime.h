@@ -1,9 +1,9 @@
 #pragma once
 
 #include <vector>
-#include <deque>
 #include <cstdint>
 #include "Events.h"
+#include "RingBuffer.h"
 
 namespace AlgoCatalyst {
 
@@ -36,6 +36,9 @@ public:
     
     // Get position multiplier based on regime
     double getPositionMultiplier() const;
+
+    // Forget tick history and centroids (start of a new run)
+    void reset();
     
 private:
     // Feature vector for clustering (volatility, direction, volume)
@@ -45,13 +48,21 @@ private:
         double volume_norm;
     };
     
+    // The part of a tick the features use; 16 bytes per history entry
+    struct Sample {
+        double price;
+        std::int64_t volume;
+    };
+    using History = RingBuffer<Sample>;
+    using HistoryIt = History::const_iterator;
+
     // k-Means clustering implementation
     void performKMeans(const std::vector<Feature>& features);
-    std::vector<Feature> extractFeatures(const std::deque<Tick>& ticks);
+    std::vector<Feature> extractFeatures(const History& ticks);
     double calculateDistance(const Feature& a, const Feature& b);
     Feature calculateCentroid(const std::vector<Feature>& cluster);
     
-    std::deque<Tick> tick_history_;
+    History tick_history_;
     std::size_t lookback_;
     std::size_t num_clusters_;
     Regime current_regime_;
@@ -59,11 +70,11 @@ private:
     // k-Means centroids
     std::vector<Feature> centroids_;
     
-    // Calculate volatility (standard deviation of returns)
-    double calculateVolatility(const std::deque<Tick>& ticks);
+    // Calculate volatility (standard deviation of returns) over [first, last)
+    double calculateVolatility(HistoryIt first, HistoryIt last);
     
-    // Calculate directional movement
-    double calculateDirection(const std::deque<Tick>& ticks);
+    // Calculate directional movement over [first, last)
+    double calculateDirection(HistoryIt first, HistoryIt last);
 };
 
 } // namespace AlgoCatalyst
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace AlgoCatalyst {
+
+// Indicators over a whole column at once, for research over historical data.
+// out[i] is what the matching Indicators getter returns after the first i+1
+// inputs were fed to it one at a time, warm-up values included, to within
+// floating-point rounding (about 1e-12 relative). Outputs must be at least as
+// long as the inputs; std::invalid_argument otherwise, or for a zero period.
+//
+// Recursive indicators (EMA, RSI, ATR, MACD) run the streaming code over the
+// warm-up and then evaluate the recurrence y[t] = z[t] + c * y[t-1] as a
+// blocked prefix scan: four values are scanned inside one AVX2 register and
+// only the carry between registers is serial. Bollinger Bands scan what
+// enters minus what leaves the window, for the sum and for the sliding
+// Welford sum of squared deviations, restarting from exact sums every few
+// thousand values so rounding cannot accumulate. A window of one repeated
+// price has exactly zero band width here, where the streaming update can
+// carry a residue of order 1e-7 until its next resync. The AVX2 kernels are
+// chosen at run time when the CPU has AVX2 and FMA; scalar kernels are used
+// otherwise. Both work through the column in cache-sized chunks.
+class BatchIndicators {
+public:
+    static void ema(std::span<const double> prices, std::size_t period, std::span<double> out);
+
+    static void rsi(std::span<const double> prices, std::size_t period, std::span<double> out);
+
+    static void bollinger(std::span<const double> prices, std::size_t period, double std_dev_mult,
+                          std::span<double> upper, std::span<double> middle, std::span<double> lower);
+
+    static void atr(std::span<const double> high, std::span<const double> low, std::span<const double> close,
+                    std::size_t period, std::span<double> out);
+
+    // MACD 12/26 line, 9-period signal and histogram
+    static void macd(std::span<const double> prices, std::span<double> macd, std::span<double> signal,
+                     std::span<double> histogram);
+
+    // Whether the AVX2 kernels are in use
+    static bool simdEnabled();
+    // Turn the AVX2 kernels off (or back on, if the CPU has them); for comparisons
+    static void setSimdEnabled(bool enabled);
+};
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Events.h"
+#include "TickFilter.h"
+#include "TickSource.h"
+
+namespace AlgoCatalyst {
+
+// One tick file of a dataset, as recorded in its manifest
+struct DatasetPartition {
+    std::string symbol;
+    std::string path;                    // Relative to the dataset root
+    std::uint64_t rows = 0;
+    std::int64_t first_timestamp_us = 0;
+    std::int64_t last_timestamp_us = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t checksum = 0;          // FNV-1a 64 of the file contents
+};
+
+// A directory tree of tick files, one directory per symbol holding one file
+// per day (or any other time slice): <root>/<SYMBOL>/<date>.csv|.actk|.actz.
+// <root>/manifest.csv records each file's symbol, row count, time range, size
+// and checksum, so a run picks the partitions it needs without opening any
+// file. Layout and manifest columns are documented in docs/tick_format.md.
+class Dataset {
+public:
+    static constexpr const char* kManifestName = "manifest.csv";
+
+    // Read <root>/manifest.csv; nullptr (with an error on stderr) if it is
+    // missing or malformed
+    static std::shared_ptr<const Dataset> open(const std::string& root);
+
+    // Scan <root>/<symbol>/ for tick files, read each once and (re)write the
+    // manifest. False (with an error on stderr) if a file cannot be read.
+    static bool buildIndex(const std::string& root);
+
+    // FNV-1a 64 of a file's contents; false if it cannot be read
+    static bool checksumFile(const std::string& path, std::uint64_t& checksum, std::uint64_t& bytes);
+
+    const std::string& root() const { return root_; }
+    std::span<const DatasetPartition> partitions() const { return partitions_; }
+
+    // Symbols with at least one partition, sorted
+    std::vector<std::string> symbols() const;
+
+    // Partitions of 'symbol' whose time range can hold a tick passing
+    // 'filter', in time order
+    std::vector<const DatasetPartition*> select(std::string_view symbol, const TickFilter& filter = {}) const;
+
+    // Absolute path of a partition's file
+    std::string pathOf(const DatasetPartition& partition) const { return root_ + "/" + partition.path; }
+
+    // Re-read every file and compare it with the manifest; returns the number
+    // of partitions that changed or went missing (each reported on stderr)
+    std::size_t verify() const;
+
+private:
+    Dataset() = default;
+
+    std::string root_;
+    std::vector<DatasetPartition> partitions_;   // By symbol, then time
+};
+
+using DatasetPtr = std::shared_ptr<const Dataset>;
+
+// Cursor over one symbol's partitions in time order. Only the partition
+// under the cursor is open; the next is opened when it runs out, so a
+// symbol's memory is one partition whatever the number of days. Files are
+// read the way loadTickData reads them (CSV parsed, .actk mapped, .actz
+// decoded block by block) with the filter applied to each.
+class PartitionedTickSource : public StreamedTickSource {
+public:
+    PartitionedTickSource(DatasetPtr dataset, std::vector<const DatasetPartition*> partitions, SymbolId symbol,
+                          const TickFilter& filter = {});
+    ~PartitionedTickSource() override;
+
+    const Tick* peek() override {
+        while (!current_ || !(head_ = current_->peek())) {
+            if (!openNext()) return nullptr;
+        }
+        return head_;
+    }
+
+    void advance() override {
+        if (!has_run_ || head_->timestamp_us != run_start_.timestamp_us) {
+            run_start_ = *head_;
+            has_run_ = true;
+        }
+        current_->advance();
+    }
+
+    bool rewind() override;
+
+    // True when every partition is a binary tick file (written sorted) and
+    // their manifest time ranges do not overlap; CSV partitions may be unsorted
+    bool isSorted() const override;
+
+    // The first tick of the run of equal timestamps consumed last (kept as a
+    // copy, since that run may lie in a partition already closed), or the head
+    const Tick* firstAtOrAfter(std::int64_t ts) override {
+        if (has_run_ && run_start_.timestamp_us >= ts) return &run_start_;
+        return peek();
+    }
+
+private:
+    // Open the next partition; false once all are consumed or one fails to open
+    bool openNext();
+
+    DatasetPtr dataset_;
+    std::vector<const DatasetPartition*> partitions_;
+    SymbolId symbol_;
+    TickFilter filter_;
+    std::size_t next_ = 0;
+    std::vector<Tick> ticks_;                    // The current partition, when it is a CSV
+    std::unique_ptr<TickSource> current_;
+    const Tick* head_ = nullptr;
+    Tick run_start_{};
+    bool has_run_ = false;
+};
+
+} // namespace AlgoCatalyst
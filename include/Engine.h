@@ -1,12 +1,22 @@
 #pragma once
 
-#include <queue>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <map>
 #include <functional>
+#include "Dataset.h"
 #include "Events.h"
+#include "EventStore.h"
+#include "FillPricer.h"
+#include "SignalEmitter.h"
+#include "StreamingTickReader.h"
+#include "TickCache.h"
+#include "TickBlocks.h"
+#include "TickFile.h"
+#include "TickFilter.h"
+#include "TickSource.h"
+#include "TickStore.h"
 
 namespace AlgoCatalyst {
 
@@ -28,12 +38,50 @@ struct TradeRecord {
     std::string strategy_name;
     double mae = 0.0;  // Maximum Adverse Excursion (worst intraday loss from entry)
     double mfe = 0.0;  // Maximum Favorable Excursion (best intraday gain from entry)
+    SymbolId symbol_id = 0;  // Interned ID of 'symbol' (merge key for sharded runs)
+};
+
+// Running realized-equity and risk state, updated in O(1) per closed trade
+struct RiskState {
+    double realized_equity = 0.0;     // Sum of net trade PnL so far
+    double peak_equity     = 0.0;     // High-water mark of realized equity
+    double max_drawdown    = 0.0;     // Largest peak-to-trough drop of realized equity
+    double daily_pnl       = 0.0;     // Realized PnL for current_day
+    std::int64_t current_day = -1;    // UTC day index (timestamp_us / US_PER_DAY); -1 before any data
+    int consec_losses      = 0;
+    int num_trades         = 0;
+    int num_wins           = 0;
+
+    // Circuit breakers; the daily-loss halt clears when a new UTC day starts
+    bool halted_drawdown   = false;
+    bool halted_daily_loss = false;
+    bool halted_consec     = false;
+
+    double drawdown() const { return peak_equity - realized_equity; }
+    bool halted() const { return halted_drawdown || halted_daily_loss || halted_consec; }
+};
+
+// A symbol's tick data opened by file format: a mapped columnar file (.actk),
+// a block-compressed file (.actz), or a CSV series from TickStore::global().
+// At most one member is set; none if the file could not be read.
+struct TickInput {
+    TickFilePtr file;
+    CompressedTickFilePtr compressed;
+    TickSeriesPtr ticks;
+
+    explicit operator bool() const { return file || compressed || ticks; }
+
+    // Detect the format by magic (CSV otherwise) and open 'path'. A CSV is
+    // parsed for 'symbol' keeping ticks that pass 'filter'; binary files are
+    // mapped whole and filtered when attached.
+    static TickInput open(const std::string& path, const std::string& symbol, const TickFilter& filter = {});
 };
 
     // Backtester Engine - Event-Driven Architecture
 class Backtester {
 public:
     explicit Backtester(double latency_ms = 200.0);
+    ~Backtester();
     
     // Execution model configuration
     void setSlippageBps(double bps) { slippage_bps_ = bps; }
@@ -46,26 +94,106 @@ public:
     void setMaxConsecLosses(int n)                { max_consec_losses_ = n; }
     void setMaxPositionsPerSymbol(int n)          { max_positions_per_symbol_ = n; }
     void setCommissionFree(bool free)             { commission_free_ = free; }
-    bool isHaltedByRisk() const                   { return risk_halt_; }
+    bool isHaltedByRisk() const                   { return risk_.halted(); }
+
+    // True if any portfolio-level circuit breaker is configured. Breakers couple
+    // symbols through shared equity, so such runs always execute on one thread.
+    bool hasPortfolioRiskLimits() const {
+        return max_drawdown_limit_ > 0.0 || max_daily_loss_ > 0.0 || max_consec_losses_ > 0;
+    }
+
+    // Cheap O(1) view of running equity / drawdown / daily PnL / loss streak
+    const RiskState& getRiskState() const         { return risk_; }
     
-    // Load tick data from CSV
-    bool loadTickData(const std::string& csv_path, const std::string& symbol);
+    // Load tick data from CSV (through TickStore::global(), so a file already
+    // loaded for this symbol is shared rather than re-parsed) or from a
+    // columnar (.actk) or block-compressed (.actz) tick file, detected by its
+    // magic, which is mapped and read in place. Only ticks passing 'filter'
+    // are loaded: CSV rows outside it are dropped once their timestamp is
+    // read, and binary files skip them by row range or block.
+    bool loadTickData(const std::string& csv_path, const std::string& symbol, const TickFilter& filter = {});
+
+    // Attach an opened TickInput through addTickFile(), addCompressedTickFile()
+    // or addTickSeries(). False if it is empty or its file lacks the symbol.
+    bool addTickInput(const std::string& symbol, const TickInput& input, const TickFilter& filter = {});
+
+    // Like loadTickData(), but a CSV is read by a StreamingTickReader as the
+    // run consumes it instead of being loaded up front: memory stays at two
+    // chunks of ticks whatever the file size, and the series is not cached.
+    // Binary tick files already stream and go through loadTickData().
+    bool streamTickData(const std::string& csv_path, const std::string& symbol, const TickFilter& filter = {});
+
+    // Attach a symbol's rows of a mapped columnar tick file for both the tick
+    // stream and fill pricing; nothing is copied. A single-symbol file is used
+    // whatever name it was written under. False if the symbol is not in the file.
+    // With a filter, the rows passing it are found by binary search up front.
+    bool addTickFile(const std::string& symbol, TickFilePtr file, const TickFilter& filter = {});
+
+    // Attach a symbol of a block-compressed tick file (.actz). Blocks are
+    // decoded one at a time as the stream reaches them, and fills are priced
+    // from the decoded blocks when they fire instead of by lookahead, so the symbol's
+    // ticks are never fully materialised.
+    bool addCompressedTickFile(const std::string& symbol, CompressedTickFilePtr file, const TickFilter& filter = {});
+
+    // Attach a symbol's partitions of a dataset. Only partitions whose
+    // manifest time range can hold a tick passing 'filter' are used; they are
+    // opened one at a time as the stream reaches them, and fills are priced
+    // from the stream when they fire. False if the dataset has no such partition.
+    bool addDataset(const std::string& symbol, DatasetPtr dataset, const TickFilter& filter = {});
+
+    // Attach a shared, read-only tick series for a symbol. The series is used
+    // for both the tick stream and fill pricing and is never copied.
+    void addTickSeries(const std::string& symbol, TickSeriesPtr ticks);
+
+    // Attach a tick cursor for a symbol; run() merges all cursors by timestamp.
+    // Replaces any source previously attached for the same symbol. Fills for a
+    // StreamedTickSource are priced by the source itself.
+    void addTickSource(const std::string& symbol, std::unique_ptr<TickSource> source);
     
     // Register strategy for a symbol
     void registerStrategy(const std::string& symbol, std::unique_ptr<Strategy> strategy);
     
+    // Shard symbols across up to n worker threads (1 = single-threaded). Each
+    // shard owns its symbols' strategies, positions and event queue; trade logs
+    // are merged in the same canonical order a single-threaded run produces.
+    // Ignored (runs single-threaded) when portfolio risk limits are set.
+    void setThreads(unsigned n)                   { threads_ = n == 0 ? 1 : n; }
+    unsigned getThreads() const                   { return threads_; }
+
+    // Console progress, summary and trade log output (on by default)
+    void setVerbose(bool verbose)                 { verbose_ = verbose; }
+
     // Run backtest
     void run();
+
+    // Clear per-run state (positions, trade log, risk state, queued events),
+    // reset registered strategies and rewind tick sources so run() can be
+    // called again on the same data. Configuration and loaded ticks are kept.
+    // Returns false if some tick source cannot rewind.
+    bool reset();
     
     // Get trade log
     const std::vector<TradeRecord>& getTradeLog() const { return trade_log_; }
+
+    // Event store counters (allocations stay flat once the store reaches steady state)
+    EventStore::Stats getEventStoreStats() const { return events_.stats(); }
+
+    // Priority queue behind the event store, applied at the next run(). The
+    // default, Auto, uses the faster radix heap when every tick source reports
+    // sorted ticks and the binary heap otherwise. Should a tick step back in
+    // time under the radix heap, the queue moves to a binary heap mid-run.
+    void setScheduler(SchedulerKind kind)         { scheduler_ = kind; }
+    SchedulerKind getScheduler() const            { return scheduler_; }
+
+    // The queue the last run used (after any fallback)
+    SchedulerKind getActiveScheduler() const      { return events_.schedulerKind(); }
     
     // Performance metrics
-    double getTotalPnL() const;
+    double getTotalPnL() const { return risk_.realized_equity; }
     int getNumTrades() const { return static_cast<int>(trade_log_.size()); }
     double getWinRate() const;
     double getSharpeRatio(double risk_free_rate = 0.0) const;
-    double getMaxDrawdown() const;
+    double getMaxDrawdown() const { return risk_.max_drawdown; }
     double getProfitFactor() const;
     double getAverageWin() const;
     double getAverageLoss() const;
@@ -81,48 +209,93 @@ public:
     bool exportTradeLogToJSON(const std::string& filepath) const;
     
 private:
-    // Event queue with custom comparator (priority queue)
-    struct EventComparator {
-        bool operator()(const EventPtr& a, const EventPtr& b) const {
-            return a->getTimestamp() > b->getTimestamp();  // Min-heap
-        }
+    // One cursor per symbol, merged k-way by timestamp in run()
+    struct TickStream {
+        SymbolId symbol;
+        std::unique_ptr<TickSource> source;
     };
-    
-    using EventQueue = std::priority_queue<EventPtr, std::vector<EventPtr>, EventComparator>;
-    
+
+    // Merge heap entry: timestamp of a stream's next tick
+    struct StreamHead {
+        std::int64_t timestamp_us;
+        std::uint32_t stream;
+    };
+
+    // Last tick seen per symbol (used to close positions at end of run)
+    struct LastQuote {
+        double price = 0.0;
+        std::int64_t timestamp_us = 0;
+        bool valid = false;
+    };
+
+    // Merge tick streams with the scheduling queue until both drain;
+    // returns the number of events processed
+    std::size_t processStreams();
+
+    // Close positions still open at end of data at each symbol's last tick
+    void closeOpenPositions();
+
+    // Build the event store for the scheduler setting; Auto asks every source
+    void selectScheduler();
+
+    // Run symbol shards on worker threads and merge their trade logs
+    std::size_t runSharded(unsigned num_shards);
+
+    // Put the trade log in canonical order (exits by time then SymbolId, then
+    // end-of-run liquidations by SymbolId) and rebuild risk_ from it
+    void canonicalizeTradeLog();
+
     // Process events
-    void processEvent(EventPtr event);
-    void processMarketUpdate(std::unique_ptr<MarketUpdateEvent> event);
-    void processSignalEvent(std::unique_ptr<SignalEvent> event);
-    void processOrderEvent(std::unique_ptr<OrderEvent> event);
-    void processFillEvent(std::unique_ptr<FillEvent> event);
+    void processEvent(const EventRecord& event);
+    void processMarketUpdate(SymbolId symbol, const Tick& tick);
+    void processSignalEvent(const EventRecord& event);
+    void processOrderEvent(const EventRecord& event);
+    void processFillEvent(const EventRecord& event);
     
     // Simulate latency between signal and fill
     std::int64_t applyLatency(std::int64_t timestamp_us) const;
+    double applySlippage(SignalEvent::Direction direction, double price) const;
     
     // Track positions and PnL
-    void updatePosition(const FillEvent& fill);
-    void closePosition(const std::string& symbol, double exit_price, std::int64_t timestamp_us);
-    
-    EventQueue event_queue_;
-    std::map<std::string, std::unique_ptr<Strategy>> strategies_;
-    std::map<std::string, std::vector<Tick>> tick_data_;
+    void updatePosition(const EventRecord& fill);
+    void closePosition(SymbolId symbol, double exit_price, std::int64_t timestamp_us);
+
+    // Fold a closed trade into risk_ and trip circuit breakers
+    void updateRiskState(double pnl, std::int64_t timestamp_us);
+
+    // Reset daily PnL (and a daily-loss halt) when the UTC day changes
+    void rollRiskDay(std::int64_t timestamp_us);
+
+    // Intern a ticker and grow the per-symbol tables to cover its ID
+    SymbolId addSymbol(const std::string& symbol);
+    void growSymbolTables(SymbolId id);
     
     // Position tracking
     struct Position {
-        std::string symbol;
-        double quantity;
-        double avg_price;
-        double total_commission;
-        SignalEvent::Direction direction;
-        std::int64_t entry_timestamp_us;
-        std::string entry_regime;
-        std::string strategy_name;
+        double quantity = 0.0;
+        double avg_price = 0.0;
+        double total_commission = 0.0;
+        SignalEvent::Direction direction = SignalEvent::Direction::LONG;
+        std::int64_t entry_timestamp_us = 0;
+        std::string entry_regime = "UNKNOWN";
+        std::string strategy_name = "Unknown";
         double mae = 0.0;
         double mfe = 0.0;
     };
-    
-    std::map<std::string, Position> positions_;
+
+    SchedulerKind scheduler_ = SchedulerKind::Auto;
+    EventStore events_{SchedulerKind::BinaryHeap};
+    SignalEmitter signal_out_;            // Reused for every strategy call
+    std::vector<TickStream> streams_;
+
+    // Per-symbol state, indexed by SymbolId
+    std::vector<std::unique_ptr<Strategy>> strategies_;
+    std::vector<TickSeriesPtr> tick_data_;
+    std::vector<TickFilePtr> tick_files_;   // Mapped columnar storage backing a symbol's pricer
+    std::vector<FillPricer> fill_pricers_;
+    std::vector<StreamedTickSource*> streamed_sources_;   // Set: fills are priced when they fire
+    std::vector<Position> positions_;
+    std::vector<LastQuote> last_quotes_;
     std::vector<TradeRecord> trade_log_;
     
     double latency_ms_;
@@ -134,20 +307,36 @@ private:
     int    max_consec_losses_    = -1;    // -1 = disabled
     int    max_positions_per_symbol_ = 1;
     bool   commission_free_      = false;
-    bool   risk_halt_            = false;
-    int    current_consec_losses_ = 0;
-    double peak_equity_ = 0.0;
-    double daily_pnl_ = 0.0;
+    RiskState risk_;
+    std::size_t liquidation_begin_ = 0;   // First end-of-run liquidation in trade_log_
+    unsigned threads_ = 1;
+    bool verbose_ = true;
     std::int64_t current_time_us_;
 };
 
-// CSV Tick Loader
+// Tick file ingestion settings
+struct TickLoadOptions {
+    unsigned threads = 0;                        // Parser threads; 0 = hardware concurrency
+    std::size_t min_chunk_bytes = 8u << 20;      // Files below 2 chunks parse on one thread
+    TickFilter filter;                           // Rows outside it are dropped after their timestamp is read
+    bool verbose = true;                         // Print the "Loaded N ticks" line
+    TickCacheMode cache = TickCacheMode::Off;    // Side-car "<csv>.tickcache" of the parsed ticks
+};
+
+// CSV Tick Loader. Memory-maps the file and parses rows in place with
+// std::from_chars; no per-row allocations. Large files are split at line
+// boundaries and parsed in parallel; warnings, line numbers and the tick
+// order are the same as a single-threaded parse.
+// With a TickCacheMode other than Off, an unfiltered parse also writes a
+// TickCache side-car, and later loads of the unchanged file (same path, size,
+// mtime and content hash) copy the ticks from it without parsing. Per-row
+// warnings are printed only when the file is parsed.
 class TickLoader {
 public:
-    static std::vector<Tick> loadFromCSV(const std::string& filepath);
-    
-private:
-    static std::int64_t parseTimestamp(const std::string& ts_str);
+    static std::vector<Tick> loadFromCSV(const std::string& filepath, const TickLoadOptions& options = {});
+
+    // Integer microseconds or ISO 8601 UTC ("2024-01-15T09:30:00.123456[Z|+HH:MM]"); 0 if unparseable
+    static std::int64_t parseTimestamp(std::string_view ts_str);
 };
 
 } // namespace AlgoCatalyst
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Events.h"
+#include "Scheduler.h"
+
+namespace AlgoCatalyst {
+
+// Compact tagged-variant event record used by the Backtester's scheduling queue.
+// Market updates point at the tick in the backtester's tick storage instead of
+// copying it; signal, order and fill events share a single order payload.
+struct EventRecord {
+    struct OrderPayload {
+        double quantity;
+        double price;
+        double commission;
+    };
+
+    EventType type;
+    SignalEvent::Direction direction;
+    SymbolId symbol;
+    std::int64_t timestamp_us;
+    union {
+        const Tick* tick;       // MarketUpdate
+        OrderPayload order;     // SignalEvent / OrderEvent / FillEvent
+    };
+};
+
+// Pooled, allocation-free event store.
+//
+// Records live in fixed-size slabs recycled through a free list; a pluggable
+// Scheduler only orders small (timestamp, sequence, slot) keys. Events with
+// equal timestamps pop in insertion order. Once the slabs and scheduler have
+// grown to the peak number of in-flight events, push/pop perform no heap
+// allocation.
+//
+// A radix heap rejects an event earlier than the last one popped; the store
+// then moves the queued keys to a binary heap and carries on, so a series
+// that steps back in time slows the run down instead of failing it.
+class EventStore {
+public:
+    struct Stats {
+        std::size_t allocations = 0;  // Slab + index + scheduler growths (general-purpose heap allocations)
+        std::size_t live        = 0;  // Events currently queued
+        std::size_t peak_live   = 0;  // High-water mark of queued events
+        std::uint64_t pushed    = 0;  // Total events ever pushed
+        std::size_t fallbacks   = 0;  // Radix heap swapped for a binary heap on a backward push
+    };
+
+    static constexpr std::size_t kSlabSize = 4096;
+
+    explicit EventStore(SchedulerKind kind = SchedulerKind::BinaryHeap)
+        : scheduler_(makeScheduler(kind)) {}
+
+    SchedulerKind schedulerKind() const { return scheduler_->kind(); }
+
+    // Pre-size slabs and scheduler for 'capacity' simultaneously queued events
+    void reserve(std::size_t capacity);
+
+    void push(const EventRecord& record);
+
+    // Earliest event (ties broken by insertion order). Undefined if empty.
+    const EventRecord& top() { return slot(scheduler_->top().slot); }
+
+    // Copy out and remove the earliest event
+    EventRecord pop();
+
+    bool empty() const { return scheduler_->empty(); }
+    std::size_t size() const { return scheduler_->size(); }
+    std::size_t capacity() const { return slabs_.size() * kSlabSize; }
+
+    // Drop all queued events but keep the pooled memory
+    void clear();
+
+    Stats stats() const {
+        Stats s = stats_;
+        s.allocations += scheduler_->allocations();
+        return s;
+    }
+
+private:
+    using Slot = std::uint32_t;
+
+    EventRecord& slot(Slot s) { return slabs_[s / kSlabSize][s % kSlabSize]; }
+    const EventRecord& slot(Slot s) const { return slabs_[s / kSlabSize][s % kSlabSize]; }
+
+    void addSlab();
+
+    // Replace the scheduler with a binary heap holding the same keys
+    void fallBackToBinaryHeap();
+
+    std::vector<std::unique_ptr<EventRecord[]>> slabs_;
+    std::vector<Slot> free_slots_;
+    std::unique_ptr<Scheduler> scheduler_;
+    std::uint64_t next_seq_ = 0;
+    Stats stats_;
+};
+
+} // namespace AlgoCatalyst
@@ -4,6 +4,8 @@
 #include <chrono>
 #include <memory>
 #include <cstdint>
+#include <type_traits>
+#include "SymbolTable.h"
 
 namespace AlgoCatalyst {
 
@@ -15,17 +17,20 @@ enum class EventType {
     FillEvent
 };
 
-// Market Tick Data
-struct Tick {
+// Market Tick Data. Plain data in one cache line, so tick buffers copy with
+// memcpy; the ticker text lives in the SymbolTable, not in every tick.
+struct alignas(64) Tick {
     std::int64_t timestamp_us;  // Microseconds since epoch
     double price;
     std::int64_t volume;
     double bid_size;
     double ask_size;
-    std::string symbol;         // Symbol this tick belongs to
     double high;                // Tick high (for ATR / candle reconstruction)
     double low;                 // Tick low
+    SymbolId symbol_id;         // Interned symbol this tick belongs to (symbolName() for the text)
 };
+static_assert(sizeof(Tick) == 64, "Tick fills exactly one cache line");
+static_assert(std::is_trivially_copyable_v<Tick>, "Tick is copied with memcpy");
 
 // Base Event class
 class Event {
@@ -43,16 +48,17 @@ private:
     std::int64_t timestamp_us_;
 };
 
-// MarketUpdate Event
+// MarketUpdate Event - refers to the tick in the caller's storage rather than
+// copying it; the tick must outlive the event.
 class MarketUpdateEvent : public Event {
 public:
     MarketUpdateEvent(std::int64_t timestamp_us, const Tick& tick)
-        : Event(EventType::MarketUpdate, timestamp_us), tick_(tick) {}
+        : Event(EventType::MarketUpdate, timestamp_us), tick_(&tick) {}
     
-    const Tick& getTick() const { return tick_; }
+    const Tick& getTick() const { return *tick_; }
     
 private:
-    Tick tick_;
+    const Tick* tick_;
 };
 
 // SignalEvent - Strategy decision
@@ -64,19 +70,20 @@ public:
         EXIT
     };
     
-    SignalEvent(std::int64_t timestamp_us, const std::string& symbol, 
+    SignalEvent(std::int64_t timestamp_us, SymbolId symbol, 
                 Direction direction, double quantity, double price)
         : Event(EventType::SignalEvent, timestamp_us),
           symbol_(symbol), direction_(direction), 
           quantity_(quantity), price_(price) {}
     
-    std::string getSymbol() const { return symbol_; }
+    SymbolId getSymbolId() const { return symbol_; }
+    const std::string& getSymbol() const { return symbolName(symbol_); }
     Direction getDirection() const { return direction_; }
     double getQuantity() const { return quantity_; }
     double getPrice() const { return price_; }
     
 private:
-    std::string symbol_;
+    SymbolId symbol_;
     Direction direction_;
     double quantity_;
     double price_;
@@ -85,19 +92,20 @@ private:
 // OrderEvent - Order submission
 class OrderEvent : public Event {
 public:
-    OrderEvent(std::int64_t timestamp_us, const std::string& symbol,
+    OrderEvent(std::int64_t timestamp_us, SymbolId symbol,
                SignalEvent::Direction direction, double quantity, double price)
         : Event(EventType::OrderEvent, timestamp_us),
           symbol_(symbol), direction_(direction),
           quantity_(quantity), price_(price) {}
     
-    std::string getSymbol() const { return symbol_; }
+    SymbolId getSymbolId() const { return symbol_; }
+    const std::string& getSymbol() const { return symbolName(symbol_); }
     SignalEvent::Direction getDirection() const { return direction_; }
     double getQuantity() const { return quantity_; }
     double getPrice() const { return price_; }
     
 private:
-    std::string symbol_;
+    SymbolId symbol_;
     SignalEvent::Direction direction_;
     double quantity_;
     double price_;
@@ -106,21 +114,22 @@ private:
 // FillEvent - Order execution confirmation
 class FillEvent : public Event {
 public:
-    FillEvent(std::int64_t timestamp_us, const std::string& symbol,
+    FillEvent(std::int64_t timestamp_us, SymbolId symbol,
               SignalEvent::Direction direction, double quantity, 
               double fill_price, double commission = 0.0)
         : Event(EventType::FillEvent, timestamp_us),
           symbol_(symbol), direction_(direction),
           quantity_(quantity), fill_price_(fill_price), commission_(commission) {}
     
-    std::string getSymbol() const { return symbol_; }
+    SymbolId getSymbolId() const { return symbol_; }
+    const std::string& getSymbol() const { return symbolName(symbol_); }
     SignalEvent::Direction getDirection() const { return direction_; }
     double getQuantity() const { return quantity_; }
     double getFillPrice() const { return fill_price_; }
     double getCommission() const { return commission_; }
     
 private:
-    std::string symbol_;
+    SymbolId symbol_;
     SignalEvent::Direction direction_;
     double quantity_;
     double fill_price_;
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include "Events.h"
+#include "StridedView.h"
+#include "TickFilter.h"
+
+namespace AlgoCatalyst {
+
+// Finds the first tick at or after a timestamp in one symbol's time-sorted tick
+// series. Fill times only move forward in a backtest, so queries walk a
+// monotonic cursor (galloping over large gaps) for amortized O(1) lookups; a
+// query earlier than the previous one falls back to a binary search.
+//
+// Works on either an array of Ticks or separate timestamp / price columns
+// (e.g. a memory-mapped columnar tick file); only those two fields are read.
+// restrictTo() makes it skip ticks a load filter left out of the stream.
+class FillPricer {
+public:
+    FillPricer() = default;
+    explicit FillPricer(std::span<const Tick> ticks)
+        : ticks_(ticks.data()),
+          timestamps_(ticks.empty() ? nullptr : &ticks.front().timestamp_us, ticks.size(), sizeof(Tick)),
+          prices_(ticks.empty() ? nullptr : &ticks.front().price, ticks.size(), sizeof(Tick)) {}
+    FillPricer(std::span<const std::int64_t> timestamps, std::span<const double> prices)
+        : timestamps_(timestamps.data(), timestamps.size()),
+          prices_(prices.data(), prices.size()) {}
+
+    // Index of the first tick with timestamp_us >= ts, or size() if the series ends before ts
+    std::size_t indexAtOrAfter(std::int64_t ts) {
+        if (ts < last_query_us_) {
+            // Out-of-order query: every tick at or past the cursor is >= the old query,
+            // so the answer lies in [0, cursor_] — binary search it
+            cursor_ = lowerBound(0, cursor_, ts);
+        } else {
+            advanceTo(ts);
+        }
+        last_query_us_ = ts;
+        return cursor_;
+    }
+
+    // Price of the first tick at or after ts, or nullptr past the end
+    const double* priceAtOrAfter(std::int64_t ts) {
+        std::size_t i = passingIndexAtOrAfter(ts);
+        return i < size() ? &prices_[i] : nullptr;
+    }
+
+    // First tick at or after ts, or nullptr past the end (Tick-backed pricers only)
+    const Tick* firstAtOrAfter(std::int64_t ts) {
+        std::size_t i = passingIndexAtOrAfter(ts);
+        return ticks_ && i < size() ? ticks_ + i : nullptr;
+    }
+
+    // Price only from ticks that pass 'filter' (e.g. in-session ticks of a
+    // columnar file whose stream skips the rest)
+    void restrictTo(const TickFilter& filter) {
+        filter_ = filter;
+        filtered_ = !filter.passesAll();
+    }
+
+    std::size_t size() const { return timestamps_.size(); }
+
+    void reset() {
+        cursor_ = 0;
+        last_query_us_ = std::numeric_limits<std::int64_t>::min();
+    }
+
+private:
+    std::size_t passingIndexAtOrAfter(std::int64_t ts) {
+        std::size_t i = indexAtOrAfter(ts);
+        while (filtered_ && i < size() && !filter_.contains(timestamps_[i])) {
+            std::int64_t next = filter_.nextInside(timestamps_[i]);
+            if (next >= filter_.end_us) return size();
+            i = indexAtOrAfter(next);
+        }
+        return i;
+    }
+
+    // First index in [lo, hi) whose timestamp is >= ts (hi if none)
+    std::size_t lowerBound(std::size_t lo, std::size_t hi, std::int64_t ts) const {
+        while (lo < hi) {
+            std::size_t mid = lo + (hi - lo) / 2;
+            if (timestamps_[mid] < ts) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // Gallop forward from the cursor, then binary search the bracketed range
+    void advanceTo(std::int64_t ts) {
+        const std::size_t n = size();
+        if (cursor_ >= n || timestamps_[cursor_] >= ts) return;
+
+        std::size_t lo = cursor_;   // timestamps_[lo] < ts
+        std::size_t step = 1;
+        while (lo + step < n && timestamps_[lo + step] < ts) {
+            lo += step;
+            step *= 2;
+        }
+        std::size_t hi = std::min(lo + step, n);
+        cursor_ = lowerBound(lo + 1, hi, ts);
+    }
+
+    const Tick* ticks_ = nullptr;
+    StridedView<std::int64_t> timestamps_;
+    StridedView<double> prices_;
+    std::size_t cursor_ = 0;
+    std::int64_t last_query_us_ = std::numeric_limits<std::int64_t>::min();
+    TickFilter filter_;
+    bool filtered_ = false;
+};
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace AlgoCatalyst {
+
+// Per-period state of the recursive indicators. Indicators keeps these in
+// maps keyed by a runtime period; the fixed-period templates below hold one
+// directly. Both drive the same update code, so for a given period they
+// produce the same values bit for bit.
+
+// EMA with an SMA warm-up over the first 'period' values
+struct EMAState {
+    double value = 0.0;
+    std::size_t tick_count = 0;
+
+    void update(double price, std::size_t period) {
+        if (tick_count++ == 0) {
+            value = price;
+        } else if (tick_count <= period) {
+            value += (price - value) / tick_count;
+        } else {
+            double alpha = 2.0 / (period + 1.0);
+            value = alpha * price + (1.0 - alpha) * value;
+        }
+    }
+    // 0 until warmed up
+    double get(std::size_t period) const { return tick_count >= period ? value : 0.0; }
+};
+
+// RSI with SMA-seeded Wilder smoothing
+struct RSIState {
+    double avg_gain = 0.0;
+    double avg_loss = 0.0;
+    double prev_price = 0.0;
+    std::size_t tick_count = 0;
+
+    void update(double price, std::size_t period) {
+        if (tick_count++ == 0) {
+            prev_price = price;
+            return;
+        }
+        double change = price - prev_price;
+        double gain = (change > 0.0) ? change : 0.0;
+        double loss = (change < 0.0) ? -change : 0.0;
+        if (tick_count <= period) {
+            avg_gain += (gain - avg_gain) / tick_count;
+            avg_loss += (loss - avg_loss) / tick_count;
+        } else {
+            double alpha = 1.0 / period;
+            avg_gain = alpha * gain + (1.0 - alpha) * avg_gain;
+            avg_loss = alpha * loss + (1.0 - alpha) * avg_loss;
+        }
+        prev_price = price;
+    }
+    // 50 (neutral) until warmed up
+    double get(std::size_t period) const {
+        if (tick_count < period) return 50.0;
+        if (avg_loss == 0.0) return 100.0;
+        double rs = avg_gain / avg_loss;
+        return 100.0 - (100.0 / (1.0 + rs));
+    }
+};
+
+// ATR with an SMA warm-up, then Wilder smoothing
+struct ATRState {
+    double atr = 0.0;
+    double prev_close = 0.0;
+    std::size_t tick_count = 0;
+
+    void update(double high, double low, double close, std::size_t period) {
+        if (tick_count++ == 0) {
+            atr = high - low;
+        } else {
+            double tr = std::max({high - low, std::abs(high - prev_close), std::abs(low - prev_close)});
+            if (tick_count <= period) atr += (tr - atr) / tick_count;
+            else                      atr = (atr * (period - 1) + tr) / period;
+        }
+        prev_close = close;
+    }
+    // 0 until warmed up
+    double get(std::size_t period) const { return tick_count >= period ? atr : 0.0; }
+};
+
+// DEMA = 2 * EMA - EMA(EMA)
+struct DEMAState {
+    double ema1 = 0.0;
+    double ema2 = 0.0;
+    std::size_t tick_count = 0;
+
+    void update(double price, std::size_t period) {
+        if (tick_count++ == 0) {
+            ema1 = ema2 = price;
+        } else if (tick_count <= period) {
+            ema1 += (price - ema1) / tick_count;
+            ema2 += (ema1 - ema2) / tick_count;
+        } else {
+            double alpha = 2.0 / (period + 1.0);
+            ema1 = alpha * price + (1.0 - alpha) * ema1;
+            ema2 = alpha * ema1 + (1.0 - alpha) * ema2;
+        }
+    }
+    // 0 until warmed up
+    double get(std::size_t period) const { return tick_count >= period ? 2.0 * ema1 - ema2 : 0.0; }
+};
+
+// TRIX: percent rate of change of a triple-smoothed EMA
+struct TRIXState {
+    double ema1 = 0.0, ema2 = 0.0, ema3 = 0.0;
+    double prev_ema3 = 0.0;
+    double value = 0.0;
+    std::size_t tick_count = 0;
+
+    void update(double price, std::size_t period) {
+        if (tick_count++ == 0) {
+            ema1 = ema2 = ema3 = prev_ema3 = price;
+            return;
+        }
+        if (tick_count <= period) {
+            ema1 += (price - ema1) / tick_count;
+            ema2 += (ema1  - ema2) / tick_count;
+            ema3 += (ema2  - ema3) / tick_count;
+        } else {
+            double alpha = 2.0 / (period + 1.0);
+            ema1 = alpha * price + (1.0 - alpha) * ema1;
+            ema2 = alpha * ema1  + (1.0 - alpha) * ema2;
+            ema3 = alpha * ema2  + (1.0 - alpha) * ema3;
+        }
+        value = prev_ema3 != 0.0 ? (ema3 - prev_ema3) / prev_ema3 * 100.0 : 0.0;
+        prev_ema3 = ema3;
+    }
+};
+
+// MACD 12/26 with a 9-period signal line. Both EMAs start as SMAs; the
+// signal line starts at the 26th value.
+struct MACDState {
+    static constexpr std::size_t kFast = 12, kSlow = 26, kSignal = 9;
+
+    double ema_fast = 0.0;
+    double ema_slow = 0.0;
+    double signal = 0.0;
+    std::size_t tick_count = 0;
+
+    // True once the signal line exists
+    bool update(double price) {
+        tick_count++;
+        if (tick_count == 1) {
+            ema_fast = price;
+            ema_slow = price;
+        } else if (tick_count <= kFast) {
+            ema_fast += (price - ema_fast) / tick_count;
+            ema_slow += (price - ema_slow) / tick_count;
+        } else if (tick_count <= kSlow) {
+            double alpha_fast = 2.0 / (kFast + 1.0);
+            ema_fast = alpha_fast * price + (1.0 - alpha_fast) * ema_fast;
+            ema_slow += (price - ema_slow) / tick_count;
+        } else {
+            double alpha_fast = 2.0 / (kFast + 1.0);
+            double alpha_slow = 2.0 / (kSlow + 1.0);
+            ema_fast = alpha_fast * price + (1.0 - alpha_fast) * ema_fast;
+            ema_slow = alpha_slow * price + (1.0 - alpha_slow) * ema_slow;
+        }
+
+        if (tick_count < kSlow) return false;
+        if (tick_count == kSlow) {
+            signal = macd();
+        } else {
+            double alpha_signal = 2.0 / (kSignal + 1.0);
+            signal = alpha_signal * macd() + (1.0 - alpha_signal) * signal;
+        }
+        return true;
+    }
+    double macd() const { return ema_fast - ema_slow; }
+};
+
+// Fixed-period indicators. The period is a template argument, so a strategy
+// that always uses the same periods declares them as plain members (e.g.
+// EMA<9>, EMA<200>) and each update is inlined with its constants folded,
+// with no map lookup on update or read. Indicators keeps the runtime-period
+// API for periods chosen from configuration.
+
+template <std::size_t Period>
+class EMA {
+    static_assert(Period > 0, "EMA period must be positive");
+public:
+    static constexpr std::size_t period = Period;
+
+    void update(double price) { state_.update(price, Period); }
+    double value() const { return state_.get(Period); }   // 0 until warmed up
+    bool isPriceAbove(double price) const { double v = value(); return v > 0.0 && price > v; }
+    void reset() { state_ = {}; }
+
+private:
+    EMAState state_;
+};
+
+template <std::size_t Period>
+class RSI {
+    static_assert(Period > 0, "RSI period must be positive");
+public:
+    static constexpr std::size_t period = Period;
+
+    void update(double price) { state_.update(price, Period); }
+    double value() const { return state_.get(Period); }   // 50 until warmed up
+    bool isOversold(double threshold = 30.0) const { return value() < threshold; }
+    bool isOverbought(double threshold = 70.0) const { return value() > threshold; }
+    void reset() { state_ = {}; }
+
+private:
+    RSIState state_;
+};
+
+template <std::size_t Period>
+class ATR {
+    static_assert(Period > 0, "ATR period must be positive");
+public:
+    static constexpr std::size_t period = Period;
+
+    void update(double high, double low, double close) { state_.update(high, low, close, Period); }
+    double value() const { return state_.get(Period); }   // 0 until warmed up
+    double percentOf(double price) const { return price == 0.0 ? 0.0 : (value() / price) * 100.0; }
+    void reset() { state_ = {}; }
+
+private:
+    ATRState state_;
+};
+
+template <std::size_t Period>
+class DEMA {
+    static_assert(Period > 0, "DEMA period must be positive");
+public:
+    static constexpr std::size_t period = Period;
+
+    void update(double price) { state_.update(price, Period); }
+    double value() const { return state_.get(Period); }   // 0 until warmed up
+    void reset() { state_ = {}; }
+
+private:
+    DEMAState state_;
+};
+
+template <std::size_t Period>
+class TRIX {
+    static_assert(Period > 0, "TRIX period must be positive");
+public:
+    static constexpr std::size_t period = Period;
+
+    void update(double price) { state_.update(price, Period); }
+    double value() const { return state_.value; }
+    bool isBullish() const { return state_.value > 0.0; }
+    void reset() { state_ = {}; }
+
+private:
+    TRIXState state_;
+};
+
+} // namespace AlgoCatalyst
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <vector>
-#include <deque>
 #include <map>
 #include <cstdint>
 #include "Events.h"
+#include "FixedIndicators.h"
+#include "RingBuffer.h"
+#include "RollingMinMax.h"
+#include "RollingStats.h"
 
 namespace AlgoCatalyst {
 
-// Indicator Calculation Engine
+// Indicator Calculation Engine. Periods are runtime arguments, and each
+// recursive indicator keeps one state per period in a map. Strategies with
+// fixed periods can use the templates in FixedIndicators.h instead.
 class Indicators {
 public:
     Indicators();
@@ -68,10 +73,10 @@ public:
     void updateWMA(double price, std::size_t period);
     double getWMA(std::size_t period) const;
 
-    // OBV (On-Balance Volume)
-    void updateOBV(double price, std::int64_t volume);
+    // OBV (On-Balance Volume), with an EMA of it over 'ema_period' values
+    void updateOBV(double price, std::int64_t volume, std::size_t ema_period = 20);
     double getOBV() const;
-    double getOBVEMA(std::size_t period = 20) const;
+    double getOBVEMA() const;  // OBV itself until ema_period values are seen
 
     // Williams %R
     void updateWilliamsR(double high, double low, double close, std::size_t period = 14);
@@ -91,7 +96,8 @@ public:
     void updateDEMA(double price, std::size_t period);
     double getDEMA(std::size_t period) const;
 
-    // CCI (Commodity Channel Index)
+    // CCI (Commodity Channel Index). The mean deviation is O(period) per
+    // update: |tp - mean| has no running form once the mean moves.
     void updateCCI(double high, double low, double close, std::size_t period = 20);
     double getCCI() const;
     bool isCCIOverbought(double threshold = 100.0) const;
@@ -144,103 +150,66 @@ public:
     void reset();
     
 private:
-    // EMA storage: period -> (current_value, alpha, tick_count)
-    struct EMAState {
-        double value;
-        double alpha;
-        std::size_t tick_count;
-    };
+    // EMA storage: period -> state
     std::map<std::size_t, EMAState> emas_;
     
     // MACD components
-    double ema_12_;
-    double ema_26_;
-    double macd_signal_ema_9_;
-    std::size_t macd_tick_count_;
-    std::deque<double> macd_histogram_history_;
+    MACDState macd_;
+    RingBuffer<double> macd_histogram_history_;
     
-    // RSI components: period -> (avg_gain, avg_loss, prev_price, tick_count)
-    struct RSIState {
-        double avg_gain;
-        double avg_loss;
-        double prev_price;
-        std::size_t tick_count;
-    };
+    // RSI components: period -> state
     std::map<std::size_t, RSIState> rsi_states_;
 
     // Bollinger Bands components
-    std::deque<double> bb_price_history_;
+    RollingStats bb_prices_;
     double bb_upper_;
     double bb_middle_;
     double bb_lower_;
     std::size_t bb_period_;
     double bb_std_dev_mult_;
 
-    // ATR components: period -> (atr_value, prev_close, tick_count)
-    struct ATRState {
-        double atr;
-        double prev_close;
-        std::size_t tick_count;
-    };
+    // ATR components: period -> state
     std::map<std::size_t, ATRState> atr_states_;
 
     // Stochastic components
-    std::deque<double> stoch_highs_;
-    std::deque<double> stoch_lows_;
-    std::deque<double> stoch_k_history_;
+    RollingMinMax stoch_range_;
+    RollingStats stoch_k_window_;
     double stoch_k_ = 50.0;
     double stoch_d_ = 50.0;
 
     // WMA components: period -> (price window)
-    std::map<std::size_t, std::deque<double>> wma_windows_;
+    std::map<std::size_t, RingBuffer<double>> wma_windows_;
 
     // OBV components
     double obv_value_ = 0.0;
     double obv_prev_price_ = 0.0;
     bool obv_initialized_ = false;
-    std::deque<double> obv_history_;
+    double obv_ema_ = 0.0;
+    std::size_t obv_ema_period_ = 20;
+    std::size_t obv_count_ = 0;
 
     // Williams %R components
-    std::deque<double> wr_highs_;
-    std::deque<double> wr_lows_;
+    RollingMinMax wr_range_;
     double williams_r_ = -50.0;
 
     // Donchian Channel components
-    std::deque<double> dc_highs_;
-    std::deque<double> dc_lows_;
+    RollingMinMax dc_range_;
     double dc_upper_ = 0.0;
     double dc_lower_ = 0.0;
 
-    // DEMA components: period -> (ema1, ema2, tick_count)
-    struct DEMAState {
-        double ema1;
-        double ema2;
-        double alpha;
-        std::size_t tick_count;
-    };
+    // DEMA components: period -> state
     std::map<std::size_t, DEMAState> dema_states_;
 
     // CCI components
-    std::deque<double> cci_highs_;
-    std::deque<double> cci_lows_;
-    std::deque<double> cci_closes_;
+    RollingStats cci_typical_;
     double cci_value_ = 0.0;
 
     // CMF components
-    struct CMFBar {
-        double mfv;
-        std::int64_t volume;
-    };
-    std::deque<CMFBar> cmf_bars_;
+    RollingStats cmf_mfv_;
+    RollingStats cmf_volume_;
     double cmf_value_ = 0.0;
 
     // TRIX components: period -> triple EMA states
-    struct TRIXState {
-        double ema1, ema2, ema3;
-        double alpha;
-        double prev_ema3;
-        std::size_t tick_count;
-    };
     std::map<std::size_t, TRIXState> trix_states_;
     double trix_value_ = 0.0;
 
@@ -260,18 +229,15 @@ private:
     double minus_di_     = 0.0;
 
     // MFI components
-    struct MFIBar {
-        double typical_price;
-        double raw_mf;   // positive = up-day, negative = down-day
-    };
-    std::deque<MFIBar> mfi_bars_;
+    RollingStats mfi_pos_flow_;   // Raw money flow of up bars, 0 on down bars
+    RollingStats mfi_neg_flow_;   // And the reverse
     double mfi_prev_typical_ = 0.0;
     double mfi_value_        = 50.0;
 
     // KAMA components
     double kama_value_          = 0.0;
     bool   kama_initialized_    = false;
-    std::deque<double> kama_prices_;
+    RingBuffer<double> kama_prices_;
 
     // Pivot Points
     double pivot_  = 0.0;
@@ -284,7 +250,7 @@ private:
     std::int64_t vwap_session_start_us_;
     
     // Volume tracking
-    std::deque<std::pair<std::int64_t, std::int64_t>> volume_history_;  // (timestamp, volume)
+    RingBuffer<std::pair<std::int64_t, std::int64_t>> volume_history_;  // (timestamp, volume)
     
     // Price tracking
     double prev_close_;
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace AlgoCatalyst {
+
+// Read-only memory mapping of a whole file. The contents are exposed as a
+// string_view valid for the lifetime of the object; nothing is copied. An
+// empty file opens successfully with an empty view.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path) { open(path); }
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    // Map 'path', replacing any current mapping. False if it cannot be opened.
+    bool open(const std::string& path);
+    void close();
+
+    bool is_open() const { return is_open_; }
+    std::string_view view() const { return {data_, size_}; }
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool is_open_ = false;
+};
+
+} // namespace AlgoCatalyst
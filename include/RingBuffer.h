@@ -0,0 +1,126 @@
+#pragma once
+
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace AlgoCatalyst {
+
+// Double-ended queue in one contiguous power-of-two array, indexed oldest
+// first. Sliding windows reserve their length once, after which pushes and
+// pops are a masked store and an index bump with no allocation; a push into
+// a full buffer doubles it, so an unreserved buffer still works. T must be
+// default-constructible and copyable (slots are plain array elements).
+template <typename T>
+class RingBuffer {
+public:
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return ring_->slots_[pos_ & ring_->mask_]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        const_iterator& operator++() { ++pos_; return *this; }
+        const_iterator operator++(int) { const_iterator t = *this; ++pos_; return t; }
+        const_iterator& operator--() { --pos_; return *this; }
+        const_iterator operator--(int) { const_iterator t = *this; --pos_; return t; }
+        const_iterator& operator+=(difference_type n) { pos_ += n; return *this; }
+        const_iterator& operator-=(difference_type n) { pos_ -= n; return *this; }
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const const_iterator& a, const const_iterator& b) {
+            return static_cast<difference_type>(a.pos_ - b.pos_);
+        }
+
+        bool operator==(const const_iterator& o) const { return pos_ == o.pos_; }
+        auto operator<=>(const const_iterator& o) const { return static_cast<difference_type>(pos_ - o.pos_) <=> 0; }
+
+    private:
+        friend class RingBuffer;
+        const_iterator(const RingBuffer* ring, std::size_t pos) : ring_(ring), pos_(pos) {}
+
+        const RingBuffer* ring_ = nullptr;
+        std::size_t pos_ = 0;   // Unmasked slot index; wraps with the mask on access
+    };
+
+    RingBuffer() = default;
+    explicit RingBuffer(std::size_t n) { reserve(n); }
+
+    RingBuffer(const RingBuffer& other) { *this = other; }
+    RingBuffer& operator=(const RingBuffer& other) {
+        if (this == &other) return *this;
+        clear();
+        reserve(other.capacity());
+        for (const T& v : other) push_back(v);
+        return *this;
+    }
+    RingBuffer(RingBuffer&& other) noexcept { swap(other); }
+    RingBuffer& operator=(RingBuffer&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    // Make room for at least n elements (rounded up to a power of two)
+    void reserve(std::size_t n) {
+        if (n <= capacity()) return;
+        std::size_t rounded = std::bit_ceil(n);
+        std::unique_ptr<T[]> slots(new T[rounded]);
+        for (std::size_t i = 0; i < size_; ++i) slots[i] = std::move((*this)[i]);
+        slots_ = std::move(slots);
+        head_ = 0;
+        mask_ = rounded - 1;
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity()) reserve(size_ == 0 ? 1 : size_ * 2);
+        slots_[(head_ + size_++) & mask_] = value;
+    }
+    void pop_front() {
+        head_ = (head_ + 1) & mask_;
+        --size_;
+    }
+    void pop_back() { --size_; }
+    void clear() { head_ = size_ = 0; }
+
+    // Oldest is [0], newest is [size() - 1]
+    T& operator[](std::size_t i) { return slots_[(head_ + i) & mask_]; }
+    const T& operator[](std::size_t i) const { return slots_[(head_ + i) & mask_]; }
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[size_ - 1]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::size_t capacity() const { return slots_ ? mask_ + 1 : 0; }
+
+    const_iterator begin() const { return const_iterator(this, head_); }
+    const_iterator end() const { return const_iterator(this, head_ + size_); }
+
+    void swap(RingBuffer& other) noexcept {
+        std::swap(slots_, other.slots_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+        std::swap(mask_, other.mask_);
+    }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    std::size_t head_ = 0;
+    std::size_t size_ = 0;
+    std::size_t mask_ = 0;
+};
+
+} // namespace AlgoCatalyst
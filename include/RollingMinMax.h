@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "RingBuffer.h"
+
+namespace AlgoCatalyst {
+
+// Highest high and lowest low of the last 'period' (high, low) pairs, in
+// amortised O(1) per pair. Each side is a monotonic deque: a value is dropped
+// as soon as a newer one is at least as extreme, since it can never be the
+// answer again, so the front is always the extreme of the window. The deques
+// are RingBuffers reserved to the period, so they never reallocate after setPeriod.
+class RollingMinMax {
+public:
+    explicit RollingMinMax(std::size_t period = 0) { setPeriod(period); }
+
+    // Change the window length. Shrinking keeps the newest pairs; growing
+    // keeps those seen so far, and full() waits for the rest.
+    void setPeriod(std::size_t period) {
+        if (period == period_) return;
+        period_ = period;
+        if (size_ > period_) size_ = period_;
+        max_.reserve(period_);
+        min_.reserve(period_);
+        expire();
+    }
+
+    void push(double high, double low) {
+        if (period_ == 0) return;
+        ++seq_;
+        if (size_ < period_) ++size_;
+        // Expire first so a ring of 'period' slots always has room for the new entry
+        expire();
+        while (!max_.empty() && max_.back().value <= high) max_.pop_back();
+        while (!min_.empty() && min_.back().value >= low) min_.pop_back();
+        max_.push_back({seq_, high});
+        min_.push_back({seq_, low});
+    }
+    void push(double x) { push(x, x); }
+
+    void clear() {
+        max_.clear();
+        min_.clear();
+        size_ = 0;
+    }
+
+    std::size_t period() const { return period_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return period_ > 0 && size_ == period_; }
+
+    // Extremes of the window; 0 while it is empty
+    double max() const { return max_.empty() ? 0.0 : max_.front().value; }
+    double min() const { return min_.empty() ? 0.0 : min_.front().value; }
+
+private:
+    struct Entry {
+        std::uint64_t seq;   // Position in the stream, to tell when it leaves the window
+        double value;
+    };
+
+    // Drop entries older than the last size_ pairs
+    void expire() {
+        while (!max_.empty() && max_.front().seq + size_ <= seq_) max_.pop_front();
+        while (!min_.empty() && min_.front().seq + size_ <= seq_) min_.pop_front();
+    }
+
+    std::size_t period_ = 0;
+    std::size_t size_ = 0;       // Pairs in the window, up to period_
+    std::uint64_t seq_ = 0;      // Pairs pushed since construction
+    RingBuffer<Entry> max_;      // Decreasing values, oldest first
+    RingBuffer<Entry> min_;      // Increasing values, oldest first
+};
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include "RingBuffer.h"
+
+namespace AlgoCatalyst {
+
+// Sum, mean and variance of the last 'period' values pushed, updated in O(1)
+// per value whatever the period. The sums are compensated (Neumaier) and the
+// variance is a sliding Welford update, so long windows over prices with a
+// large common offset keep their precision; every 'period' evictions the
+// state is recomputed from the window, which bounds any drift at an amortised
+// cost of one extra addition per value.
+class RollingStats {
+public:
+    explicit RollingStats(std::size_t period = 0) : period_(period), window_(period) {}
+
+    // Change the window length, keeping the newest values that still fit
+    void setPeriod(std::size_t period) {
+        if (period == period_) return;
+        period_ = period;
+        window_.reserve(period_);
+        while (window_.size() > period_) window_.pop_front();
+        resync();
+    }
+
+    void push(double x) {
+        if (period_ == 0) return;
+        if (window_.size() < period_) {
+            window_.push_back(x);
+            add(sum_, sum_comp_, x);
+            add(sum_sq_, sum_sq_comp_, x * x);
+            double delta = x - mean_;
+            mean_ += delta / static_cast<double>(window_.size());
+            m2_ += delta * (x - mean_);
+            return;
+        }
+
+        double old = window_.front();
+        window_.pop_front();
+        window_.push_back(x);
+        if (++evictions_ >= period_) {
+            resync();
+            return;
+        }
+        add(sum_, sum_comp_, x);
+        add(sum_, sum_comp_, -old);
+        add(sum_sq_, sum_sq_comp_, x * x);
+        add(sum_sq_, sum_sq_comp_, -old * old);
+        double old_mean = mean_;
+        mean_ += (x - old) / static_cast<double>(period_);
+        m2_ += (x - old) * (x - mean_ + old - old_mean);
+    }
+
+    void clear() {
+        window_.clear();
+        resync();
+    }
+
+    std::size_t period() const { return period_; }
+    std::size_t size() const { return window_.size(); }
+    bool empty() const { return window_.empty(); }
+    bool full() const { return period_ > 0 && window_.size() == period_; }
+
+    double sum() const { return sum_ + sum_comp_; }
+    double sumOfSquares() const { return sum_sq_ + sum_sq_comp_; }
+    double mean() const { return window_.empty() ? 0.0 : sum() / static_cast<double>(window_.size()); }
+
+    // Population variance (divides by the number of values)
+    double variance() const {
+        if (window_.empty() || m2_ <= 0.0) return 0.0;
+        return m2_ / static_cast<double>(window_.size());
+    }
+    double stddev() const { return std::sqrt(variance()); }
+
+    // The window, oldest first
+    RingBuffer<double>::const_iterator begin() const { return window_.begin(); }
+    RingBuffer<double>::const_iterator end() const { return window_.end(); }
+    double front() const { return window_.front(); }
+    double back() const { return window_.back(); }
+
+private:
+    // Neumaier's compensated addition: 'comp' collects the low-order bits lost from 'sum'
+    static void add(double& sum, double& comp, double x) {
+        double t = sum + x;
+        if (std::abs(sum) >= std::abs(x)) comp += (sum - t) + x;
+        else                              comp += (x - t) + sum;
+        sum = t;
+    }
+
+    // Recompute everything from the window (two-pass variance)
+    void resync() {
+        sum_ = sum_comp_ = sum_sq_ = sum_sq_comp_ = 0.0;
+        for (double v : window_) {
+            add(sum_, sum_comp_, v);
+            add(sum_sq_, sum_sq_comp_, v * v);
+        }
+        mean_ = window_.empty() ? 0.0 : sum() / static_cast<double>(window_.size());
+        m2_ = 0.0;
+        for (double v : window_) m2_ += (v - mean_) * (v - mean_);
+        evictions_ = 0;
+    }
+
+    std::size_t period_;
+    RingBuffer<double> window_;
+    double sum_ = 0.0, sum_comp_ = 0.0;
+    double sum_sq_ = 0.0, sum_sq_comp_ = 0.0;
+    double mean_ = 0.0;          // Welford running mean and sum of squared deviations
+    double m2_ = 0.0;
+    std::size_t evictions_ = 0;  // Since the last resync
+};
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace AlgoCatalyst {
+
+// Ordering key for a scheduled event: earliest timestamp first, equal
+// timestamps in insertion (seq) order. 'slot' identifies the stored record.
+struct ScheduledKey {
+    std::int64_t timestamp_us;
+    std::uint64_t seq;
+    std::uint32_t slot;
+};
+
+enum class SchedulerKind {
+    BinaryHeap,   // Comparison heap; accepts any push order
+    RadixHeap,    // Monotone integer heap; pushes may not precede the last pop
+    Auto          // Backtester setting: radix heap when every tick source is sorted
+};
+
+const char* schedulerName(SchedulerKind kind);
+
+// Priority queue of ScheduledKeys used by EventStore. top() may reorganise
+// internal storage, so it is non-const.
+class Scheduler {
+public:
+    virtual ~Scheduler() = default;
+
+    virtual SchedulerKind kind() const = 0;
+
+    // Pre-size for 'capacity' simultaneously queued keys
+    virtual void reserve(std::size_t capacity) = 0;
+
+    virtual void push(const ScheduledKey& key) = 0;
+
+    // Earliest key (ties by seq). Undefined if empty.
+    virtual const ScheduledKey& top() = 0;
+
+    virtual ScheduledKey pop() = 0;
+
+    virtual std::size_t size() const = 0;
+    bool empty() const { return size() == 0; }
+
+    virtual void clear() = 0;
+
+    // Number of times internal storage has grown (general-purpose heap allocations)
+    virtual std::size_t allocations() const = 0;
+};
+
+// Auto builds a binary heap; the Backtester resolves it before each run
+std::unique_ptr<Scheduler> makeScheduler(SchedulerKind kind);
+
+// std::push_heap / pop_heap over a flat key vector
+class BinaryHeapScheduler : public Scheduler {
+public:
+    SchedulerKind kind() const override { return SchedulerKind::BinaryHeap; }
+    void reserve(std::size_t capacity) override;
+    void push(const ScheduledKey& key) override;
+    const ScheduledKey& top() override { return heap_.front(); }
+    ScheduledKey pop() override;
+    std::size_t size() const override { return heap_.size(); }
+    void clear() override { heap_.clear(); }
+    std::size_t allocations() const override { return allocations_; }
+
+private:
+    std::vector<ScheduledKey> heap_;
+    std::size_t allocations_ = 0;
+};
+
+// Radix heap over 64-bit timestamps. Valid because the backtester never
+// schedules an event earlier than the one it last dispatched (latency only
+// moves time forward). Keys live in 65 buckets by the highest bit in which
+// they differ from the last popped timestamp; each key moves down at most 64
+// times over its life, so push is O(1) and pop amortised O(log range).
+// Bucket 0 holds keys equal to the last popped timestamp in seq order,
+// preserving FIFO ties.
+//
+// push() throws std::invalid_argument for a timestamp earlier than the last
+// popped one while keys are queued; an empty heap accepts any timestamp.
+class RadixHeapScheduler : public Scheduler {
+public:
+    SchedulerKind kind() const override { return SchedulerKind::RadixHeap; }
+    void reserve(std::size_t capacity) override;   // Reserves every bucket
+    void push(const ScheduledKey& key) override;
+    const ScheduledKey& top() override;
+    ScheduledKey pop() override;
+    std::size_t size() const override { return size_; }
+    void clear() override;
+    std::size_t allocations() const override { return allocations_; }
+
+private:
+    static constexpr std::size_t kBuckets = 65;
+
+    // Order-preserving map of signed timestamps onto unsigned radix keys
+    static std::uint64_t radix(std::int64_t ts) {
+        return static_cast<std::uint64_t>(ts) ^ (std::uint64_t{1} << 63);
+    }
+
+    std::size_t bucketFor(std::uint64_t r) const;
+    void append(std::size_t bucket, const ScheduledKey& key);
+
+    // Index of the lowest non-empty bucket above 0 (size_ > 0, bucket 0 drained)
+    std::size_t lowestBucket() const;
+
+    // Earliest key outside bucket 0; cached between pushes
+    const ScheduledKey& minOutsideFront();
+
+    // Move the lowest bucket down, re-basing on its minimum timestamp
+    void refill();
+
+    std::array<std::vector<ScheduledKey>, kBuckets> buckets_;
+    std::size_t head_ = 0;             // Next key to pop from buckets_[0]
+    std::uint64_t last_ = 0;           // Radix of the last popped timestamp
+    std::size_t size_ = 0;
+    std::size_t allocations_ = 0;
+    ScheduledKey min_key_{};
+    bool min_valid_ = false;
+};
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Events.h"
+
+namespace AlgoCatalyst {
+
+// Plain signal written by a strategy; the engine turns it into a SignalEvent record
+struct Signal {
+    std::int64_t timestamp_us;
+    SymbolId symbol;
+    SignalEvent::Direction direction;
+    double quantity;
+    double price;
+};
+
+// Reusable output buffer for strategy signals. The engine owns one emitter,
+// clears it before each strategy call and drains it afterwards, so storage is
+// reused across ticks and emitting never allocates once the buffer has grown
+// to the largest per-tick burst.
+class SignalEmitter {
+public:
+    explicit SignalEmitter(std::size_t capacity = 8) { signals_.reserve(capacity); }
+
+    void emit(std::int64_t timestamp_us, SymbolId symbol, SignalEvent::Direction direction,
+              double quantity, double price) {
+        signals_.push_back({timestamp_us, symbol, direction, quantity, price});
+    }
+
+    void clear() { signals_.clear(); }
+
+    bool empty() const { return signals_.empty(); }
+    std::size_t size() const { return signals_.size(); }
+    std::size_t capacity() const { return signals_.capacity(); }
+
+    const Signal& operator[](std::size_t i) const { return signals_[i]; }
+    std::vector<Signal>::const_iterator begin() const { return signals_.begin(); }
+    std::vector<Signal>::const_iterator end() const { return signals_.end(); }
+
+private:
+    std::vector<Signal> signals_;
+};
+
+} // namespace AlgoCatalyst
@@ -4,7 +4,9 @@
 #include <memory>
 #include <string>
 #include "Events.h"
+#include "FixedIndicators.h"
 #include "Indicators.h"
+#include "SignalEmitter.h"
 
 namespace AlgoCatalyst {
 
@@ -17,16 +19,29 @@ public:
     Strategy(const std::string& symbol);
     virtual ~Strategy() = default;
     
-    // Process market update and generate signals
-    virtual std::vector<EventPtr> processMarketUpdate(const MarketUpdateEvent& event) = 0;
+    // Process one tick and write any signals into 'out'. The engine owns and
+    // reuses 'out', so the per-tick call does not allocate for its output.
+    virtual void onMarketUpdate(const Tick& tick, SignalEmitter& out) = 0;
+
+    // Compatibility wrapper for callers of the pre-emitter API; allocates the
+    // returned events on every call, so the engine does not use it
+    std::vector<EventPtr> processMarketUpdate(const MarketUpdateEvent& event);
+
+    // Return to the freshly constructed state (indicators, position, entry
+    // tracking, attached regime classifier) for another run on the same data
+    virtual void reset();
     
     // Get current position state
     bool hasPosition() const { return position_ != 0.0; }
     double getPosition() const { return position_; }
     double getAvgFillPrice() const { return avg_fill_price_; }
+
+    const std::string& getSymbol() const { return symbol_; }
+    SymbolId getSymbolId() const { return symbol_id_; }
     
 protected:
     std::string symbol_;
+    SymbolId symbol_id_;
     double position_;
     double avg_fill_price_;
     Indicators indicators_;
@@ -37,7 +52,8 @@ class NewsMomentumStrategy : public Strategy {
 public:
     NewsMomentumStrategy(const std::string& symbol, RegimeClassifier* regime_classifier);
     
-    std::vector<EventPtr> processMarketUpdate(const MarketUpdateEvent& event) override;
+    void onMarketUpdate(const Tick& tick, SignalEmitter& out) override;
+    void reset() override;
     
     // Strategy parameters
     void setMinRelativeVolume(double vol) { min_relative_volume_ = vol; }
@@ -71,6 +87,12 @@ private:
     bool checkOrderBookImbalance(const Tick& tick);  // Bid/Ask ratio
     
     RegimeClassifier* regime_classifier_;
+
+    // Fixed-period indicators, resolved at compile time
+    EMA<9> ema_9_;
+    EMA<90> ema_90_;
+    EMA<200> ema_200_;
+    ATR<14> atr_14_;
     
     // Strategy parameters
     double min_relative_volume_ = 5.0;
@@ -112,7 +134,8 @@ class MeanReversionStrategy : public Strategy {
 public:
     MeanReversionStrategy(const std::string& symbol, RegimeClassifier* regime_classifier);
 
-    std::vector<EventPtr> processMarketUpdate(const MarketUpdateEvent& event) override;
+    void onMarketUpdate(const Tick& tick, SignalEmitter& out) override;
+    void reset() override;
 
     void setRSIPeriod(std::size_t period) { rsi_period_ = period; }
     void setOversoldThreshold(double threshold) { oversold_threshold_ = threshold; }
@@ -128,6 +151,7 @@ private:
 
     RegimeClassifier* regime_classifier_;
 
+    EMA<20> ema_20_;
     std::size_t rsi_period_ = 14;
     double oversold_threshold_ = 30.0;
     double overbought_threshold_ = 70.0;
@@ -151,7 +175,8 @@ class BreakoutStrategy : public Strategy {
 public:
     BreakoutStrategy(const std::string& symbol, RegimeClassifier* regime_classifier);
 
-    std::vector<EventPtr> processMarketUpdate(const MarketUpdateEvent& event) override;
+    void onMarketUpdate(const Tick& tick, SignalEmitter& out) override;
+    void reset() override;
 
     void setDonchianPeriod(std::size_t period) { donchian_period_ = period; }
     void setCCIPeriod(std::size_t period)       { cci_period_ = period; }
@@ -168,6 +193,7 @@ private:
 
     RegimeClassifier* regime_classifier_;
 
+    EMA<20> ema_20_;
     std::size_t donchian_period_ = 20;
     std::size_t cci_period_      = 20;
     double min_relative_volume_  = 1.5;
@@ -181,5 +207,19 @@ private:
     bool   is_long_ = true;
 };
 
-} // namespace AlgoCatalyst
+// Tunable parameters shared by the CLI, config file and parameter sweeps
+struct StrategyParams {
+    double base_position_size  = 100.0;
+    double stop_loss_pct       = 2.0;
+    double take_profit_pct     = 6.0;
+    double trailing_stop_pct   = 3.0;   // momentum / breakout only
+    double min_relative_volume = -1.0;  // momentum / breakout only; <= 0 keeps the strategy default
+};
 
+// Build a configured strategy by CLI name: momentum | meanrev | breakout.
+// Unknown names build the momentum strategy, as the CLI always has.
+std::unique_ptr<Strategy> makeStrategy(const std::string& name, const std::string& symbol,
+                                       RegimeClassifier* regime_classifier,
+                                       const StrategyParams& params);
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Events.h"
+#include "TickFilter.h"
+#include "TickSource.h"
+
+namespace AlgoCatalyst {
+
+// Pull cursor over a tick CSV that never holds more than two fixed-size chunks
+// of ticks. A read-ahead thread reads and parses the file into one chunk while
+// the engine consumes the other, so disk reads and parsing overlap the
+// simulation and peak memory does not grow with the file. Rows are parsed,
+// validated and warned about exactly as by TickLoader::loadFromCSV (the two
+// share the row parser in src/TickLoader.cpp).
+class StreamingTickReader : public StreamedTickSource {
+public:
+    static constexpr std::size_t kDefaultChunkTicks = 16384;
+    static constexpr std::size_t kReadBytes = 1u << 20;
+
+    // Opens 'path' and starts reading ahead; check is_open()
+    StreamingTickReader(std::string path, SymbolId symbol, const TickFilter& filter = {},
+                        std::size_t chunk_ticks = kDefaultChunkTicks);
+    ~StreamingTickReader() override;
+
+    StreamingTickReader(const StreamingTickReader&) = delete;
+    StreamingTickReader& operator=(const StreamingTickReader&) = delete;
+
+    // False (with an error on stderr) if the file could not be opened
+    bool is_open() const { return fd_ >= 0; }
+
+    const Tick* peek() override {
+        if (pos_ < current_->size()) return &(*current_)[pos_];
+        return nextChunk();
+    }
+
+    void advance() override {
+        const Tick* tick = &(*current_)[pos_++];
+        if (!run_start_ || tick->timestamp_us != run_start_->timestamp_us) run_start_ = tick;
+    }
+
+    bool rewind() override;
+
+    // The first tick of the run of equal timestamps consumed last, or the head
+    const Tick* firstAtOrAfter(std::int64_t ts) override {
+        if (run_start_ && run_start_->timestamp_us >= ts) return run_start_;
+        return peek();
+    }
+
+private:
+    struct Chunk {
+        std::vector<Tick> ticks;
+        bool last = false;   // Final chunk of the file (may be empty)
+    };
+
+    void start();
+    void stop();
+    void readAhead();
+    // Wait for the producer's next chunk; nullptr once the file is exhausted
+    const Tick* nextChunk();
+
+    std::string path_;
+    SymbolId symbol_;
+    TickFilter filter_;
+    std::size_t chunk_ticks_;
+    int fd_ = -1;
+
+    // Double buffer: ready_[i] means chunks_[i] belongs to the consumer
+    Chunk chunks_[2];
+    bool ready_[2] = {false, false};
+    bool stopping_ = false;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread reader_;
+
+    // Consumer side
+    const std::vector<Tick> empty_;
+    const std::vector<Tick>* current_ = &empty_;
+    std::size_t pos_ = 0;
+    int slot_ = 0;
+    bool holding_ = false;
+    bool at_end_ = false;
+    const Tick* run_start_ = nullptr;
+    Tick saved_run_start_{};   // Copy of run_start_ once its chunk is handed back
+};
+
+} // namespace AlgoCatalyst
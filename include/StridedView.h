@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+namespace AlgoCatalyst {
+
+// Read-only view of one field laid out every 'stride' bytes: a member of an
+// array of records (stride = record size) or a packed column (stride = sizeof(T)).
+template <typename T>
+class StridedView {
+public:
+    StridedView() = default;
+    StridedView(const T* first, std::size_t size, std::size_t stride = sizeof(T))
+        : base_(reinterpret_cast<const unsigned char*>(first)), size_(size), stride_(stride) {}
+
+    const T& operator[](std::size_t i) const {
+        return *reinterpret_cast<const T*>(base_ + i * stride_);
+    }
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+private:
+    const unsigned char* base_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t stride_ = sizeof(T);
+};
+
+} // namespace AlgoCatalyst
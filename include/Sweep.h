@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Engine.h"
+#include "Strategy.h"
+
+namespace AlgoCatalyst {
+
+// Value lists to sweep; every combination of one value from each list is run.
+// A single-element list pins that parameter.
+struct SweepGrid {
+    std::vector<double> stop_loss_pct       = {2.0};
+    std::vector<double> take_profit_pct     = {6.0};
+    std::vector<double> trailing_stop_pct   = {3.0};
+    std::vector<double> min_relative_volume = {-1.0};   // <= 0: strategy default
+    std::vector<double> slippage_bps        = {5.0};
+
+    // Skip combinations whose take-profit does not exceed the stop-loss
+    bool require_tp_above_sl = true;
+
+    std::size_t size() const {
+        return stop_loss_pct.size() * take_profit_pct.size() * trailing_stop_pct.size() *
+               min_relative_volume.size() * slippage_bps.size();
+    }
+};
+
+// One grid point
+struct SweepCombo {
+    StrategyParams params;
+    double slippage_bps = 5.0;
+};
+
+// Metrics for one grid point
+struct SweepResult {
+    SweepCombo combo;
+    int    num_trades    = 0;
+    double total_pnl     = 0.0;
+    double win_rate      = 0.0;
+    double profit_factor = 0.0;
+    double sharpe_ratio  = 0.0;
+    double max_drawdown  = 0.0;
+};
+
+// In-process parameter sweep. Every combination runs on a worker thread over
+// the same shared, read-only tick series; each worker reuses one Backtester
+// (reset between runs) with output silenced. Results come back in grid order
+// regardless of thread count.
+class ParameterSweep {
+public:
+    explicit ParameterSweep(std::string strategy_name = "momentum", double latency_ms = 200.0);
+
+    // Open 'path' the way Backtester::loadTickData() does (.actk, .actz or
+    // CSV) and add it; false if it cannot be read
+    bool loadTickData(const std::string& path, const std::string& symbol, const TickFilter& filter = {});
+
+    void addSeries(const std::string& symbol, TickSeriesPtr ticks);
+    void addTickFile(const std::string& symbol, TickFilePtr file, const TickFilter& filter = {});
+    void addCompressedTickFile(const std::string& symbol, CompressedTickFilePtr file, const TickFilter& filter = {});
+    void setGrid(const SweepGrid& grid) { grid_ = grid; }
+
+    // 0 = std::thread::hardware_concurrency()
+    void setThreads(unsigned n) { threads_ = n; }
+
+    // Grid points in run order (after the take-profit filter)
+    std::vector<SweepCombo> combinations() const;
+
+    // Run every combination. 'progress' (optional) is called from worker
+    // threads with the number of finished runs and the total.
+    std::vector<SweepResult> run(const std::function<void(std::size_t, std::size_t)>& progress = {}) const;
+
+    // Order by a metric name: sharpe | pnl | profit_factor | win_rate (best first)
+    static bool sortByMetric(std::vector<SweepResult>& results, const std::string& metric);
+
+    static bool writeCSV(const std::vector<SweepResult>& results, const std::string& path);
+    static void printTable(const std::vector<SweepResult>& results, std::size_t max_rows,
+                           std::ostream& out = std::cout);
+
+private:
+    std::string strategy_name_;
+    double latency_ms_;
+    unsigned threads_ = 0;
+    SweepGrid grid_;
+    // One data source per symbol: an in-memory series or a mapped tick file
+    struct Input {
+        std::string symbol;
+        TickInput data;
+        TickFilter filter;   // Applied when a worker attaches a file
+    };
+    std::vector<Input> inputs_;
+};
+
+} // namespace AlgoCatalyst
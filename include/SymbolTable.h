@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace AlgoCatalyst {
+
+// Dense integer handle for an interned ticker
+using SymbolId = std::uint32_t;
+
+// Process-wide ticker <-> SymbolId table. IDs are dense (0, 1, 2, ...) so
+// per-symbol engine state can live in plain vectors indexed by SymbolId.
+// Interning and lookup are thread-safe; returned names stay valid for the
+// lifetime of the process.
+class SymbolTable {
+public:
+    static SymbolTable& global();
+
+    // ID for 'ticker', assigning the next free ID on first sight
+    SymbolId intern(std::string_view ticker);
+
+    // True and sets 'id' if the ticker has been interned
+    bool find(std::string_view ticker, SymbolId& id) const;
+
+    const std::string& name(SymbolId id) const;
+
+    std::size_t size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::deque<std::string> names_;                        // Stable storage
+    std::unordered_map<std::string_view, SymbolId> ids_;   // Views into names_
+};
+
+inline SymbolId internSymbol(std::string_view ticker) {
+    return SymbolTable::global().intern(ticker);
+}
+
+inline const std::string& symbolName(SymbolId id) {
+    return SymbolTable::global().name(id);
+}
+
+} // namespace AlgoCatalyst
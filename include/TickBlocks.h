@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Events.h"
+#include "MappedFile.h"
+#include "TickFilter.h"
+#include "TickSource.h"
+
+namespace AlgoCatalyst {
+
+// On-disk header of a block-compressed tick file (.actz); layout documented
+// in docs/tick_format.md. All integers little-endian.
+struct TickBlockHeader {
+    static constexpr char kMagic[8] = {'A', 'C', 'T', 'Z', '\r', '\n', '\x1A', '\n'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kDefaultBlockRows = 4096;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t row_count;
+    std::uint32_t symbol_count;
+    std::uint32_t block_count;
+    std::uint64_t symbol_table_offset;
+    std::uint64_t symbol_table_size;
+    std::uint64_t block_index_offset;
+    std::uint32_t block_rows;                     // Maximum rows per block
+    std::uint32_t flags;                          // Reserved, 0
+};
+static_assert(sizeof(TickBlockHeader) == 64, "block file header is 64 bytes on disk");
+
+// Index entry for one block: where it is and which timestamps it covers
+struct TickBlockInfo {
+    std::uint64_t offset;
+    std::uint32_t size;
+    std::uint32_t rows;
+    std::int64_t min_timestamp_us;
+    std::int64_t max_timestamp_us;
+};
+static_assert(sizeof(TickBlockInfo) == 32, "block index entry is 32 bytes on disk");
+
+// Read-only, memory-mapped block-compressed tick file. Each block holds up to
+// block_rows ticks of one symbol with timestamps delta/varint coded, prices as
+// scaled-integer deltas and sizes bit-packed; the block index (timestamp
+// range per block) lets readers seek without decoding.
+class CompressedTickFile {
+public:
+    // A symbol's blocks and rows: contiguous and time-sorted
+    struct SymbolRange {
+        std::string name;
+        std::uint64_t first_row = 0;
+        std::uint64_t row_count = 0;
+        std::uint32_t first_block = 0;
+        std::uint32_t block_count = 0;
+    };
+
+    // Map and validate 'path'; nullptr (with an error on stderr) if it is not a valid block file
+    static std::shared_ptr<const CompressedTickFile> open(const std::string& path);
+
+    // True if 'path' starts with the block file magic
+    static bool isCompressedFile(const std::string& path);
+
+    // Write one or more symbols' time-sorted ticks as a block file. Fails (with
+    // an error on stderr, before creating the file) if a series is not sorted
+    // by timestamp: the block index and seeks binary search by time.
+    static bool write(const std::string& path,
+                      const std::vector<std::pair<std::string, std::span<const Tick>>>& series,
+                      std::uint32_t block_rows = TickBlockHeader::kDefaultBlockRows);
+
+    std::uint64_t rows() const { return rows_; }
+    std::uint64_t bytes() const { return file_.size(); }
+    const std::vector<SymbolRange>& symbols() const { return symbols_; }
+    std::span<const TickBlockInfo> blocks() const { return {blocks_, block_count_}; }
+
+    // Range stored under 'name', or nullptr
+    const SymbolRange* findSymbol(std::string_view name) const;
+
+    // First block of 'range' whose max timestamp is >= ts (range end if none)
+    std::uint32_t findBlock(const SymbolRange& range, std::int64_t ts) const;
+
+    // Decode block 'index' into 'out' (resized to the block's rows, storage
+    // reused). False if the block is corrupt.
+    bool decodeBlock(std::uint32_t index, SymbolId symbol, std::vector<Tick>& out) const;
+
+private:
+    CompressedTickFile() = default;
+
+    MappedFile file_;
+    std::string path_;
+    std::uint64_t rows_ = 0;
+    std::vector<SymbolRange> symbols_;
+    const TickBlockInfo* blocks_ = nullptr;
+    std::size_t block_count_ = 0;
+};
+
+using CompressedTickFilePtr = std::shared_ptr<const CompressedTickFile>;
+
+// Cursor over one symbol of a block file; decodes one block at a time into a
+// reused buffer, so memory stays at one block per stream. With a filter, the
+// block index skips blocks that hold no passing tick without decoding them.
+class CompressedTickSource : public StreamedTickSource {
+public:
+    CompressedTickSource(CompressedTickFilePtr file, const CompressedTickFile::SymbolRange& range, SymbolId symbol,
+                         const TickFilter& filter = {})
+        : file_(std::move(file)), range_(range), symbol_(symbol), filter_(filter) {
+        rewind();
+    }
+
+    const Tick* peek() override {
+        while (pos_ >= buffer_.size()) {
+            if (!loadNextBlock()) return nullptr;
+        }
+        return &buffer_[pos_];
+    }
+
+    void advance() override { ++pos_; }
+
+    bool rewind() override {
+        seek(filter_.start_us);
+        return true;
+    }
+
+    // write() refuses unsorted series
+    bool isSorted() const override { return true; }
+
+    // Position on the first passing tick with timestamp >= ts; whole blocks
+    // before it are skipped undecoded
+    void seek(std::int64_t ts);
+
+    // Searches the current block, and earlier blocks while a run of equal
+    // timestamps reaches back into them
+    const Tick* firstAtOrAfter(std::int64_t ts) override;
+
+private:
+    bool loadNextBlock();
+    bool decode(std::uint32_t index, std::vector<Tick>& out) const;
+
+    CompressedTickFilePtr file_;
+    CompressedTickFile::SymbolRange range_;
+    SymbolId symbol_;
+    TickFilter filter_;
+    std::uint32_t next_block_ = 0;
+    std::vector<Tick> buffer_;
+    std::size_t pos_ = 0;
+    std::vector<Tick> lookback_;   // An earlier block decoded by firstAtOrAfter()
+    Tick found_{};
+};
+
+} // namespace AlgoCatalyst
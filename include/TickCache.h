@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Events.h"
+#include "TickFilter.h"
+
+namespace AlgoCatalyst {
+
+// Whether CSV loads go through the parsed-tick side-car cache
+enum class TickCacheMode {
+    Off,       // Always parse; never read or write a cache
+    Use,       // Read a cache whose key matches the CSV, else parse and write one
+    Rebuild    // Parse and overwrite the cache
+};
+
+// Identity of a source CSV: a cache is used only when all of it matches
+struct TickCacheKey {
+    std::uint64_t size = 0;
+    std::int64_t mtime_ns = 0;
+    std::uint64_t hash = 0;     // Of the whole contents, see TickCache::hashContents
+    std::string path;           // Absolute
+
+    // Key of the file at 'path' whose mapped contents are 'contents'; false if it cannot be stat'ed
+    static bool of(const std::string& path, std::string_view contents, TickCacheKey& out);
+
+    bool operator==(const TickCacheKey&) const = default;
+};
+
+// On-disk header of a side-car cache. Ticks follow at tick_offset as the raw
+// Tick array, so a hit costs one copy instead of a parse. Not a portable or
+// archival format: any change to Tick or to the parser bumps kVersion.
+struct TickCacheHeader {
+    static constexpr char kMagic[8] = {'A', 'C', 'T', 'C', '\r', '\n', '\x1A', '\n'};
+    static constexpr std::uint32_t kVersion = 1;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t tick_size;              // sizeof(Tick) of the writer
+    std::uint64_t source_size;
+    std::int64_t source_mtime_ns;
+    std::uint64_t source_hash;
+    std::uint64_t tick_count;
+    std::uint64_t skipped_rows;           // Malformed rows the parse skipped
+    std::uint32_t path_size;              // Source path follows the header
+    std::uint32_t reserved;
+    std::uint64_t tick_offset;            // 64-byte aligned
+};
+static_assert(sizeof(TickCacheHeader) == 72, "tick cache header is 72 bytes on disk");
+
+// Side-car cache of a CSV's parsed ticks, written next to it as
+// "<csv>.tickcache". It always holds the whole file; filtered loads cut
+// their ticks from it.
+class TickCache {
+public:
+    static std::string pathFor(const std::string& csv_path) { return csv_path + ".tickcache"; }
+
+    // 64-bit hash of 'contents', 8 bytes per step (several GB/s)
+    static std::uint64_t hashContents(std::string_view contents);
+
+    // Ticks passing 'filter' from the cache at 'path' if its key is 'key';
+    // false if it is missing, stale or damaged
+    static bool read(const std::string& path, const TickCacheKey& key, const TickFilter& filter,
+                     std::vector<Tick>& ticks, std::size_t& skipped_rows);
+
+    // Write atomically (temporary file, then rename); false with a warning on stderr on failure
+    static bool write(const std::string& path, const TickCacheKey& key, std::span<const Tick> ticks,
+                      std::size_t skipped_rows);
+};
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Events.h"
+#include "MappedFile.h"
+#include "TickFilter.h"
+#include "TickSource.h"
+
+namespace AlgoCatalyst {
+
+// On-disk header of a columnar tick file (.actk); layout documented in
+// docs/tick_format.md. All integers little-endian.
+struct TickFileHeader {
+    static constexpr char kMagic[8] = {'A', 'C', 'T', 'K', '\r', '\n', '\x1A', '\n'};
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::size_t kColumns = 7;   // timestamp, price, volume, bid_size, ask_size, high, low
+    static constexpr std::size_t kAlignment = 64;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t header_size;
+    std::uint64_t row_count;
+    std::uint32_t symbol_count;
+    std::uint32_t flags;                          // Reserved, 0
+    std::uint64_t symbol_table_offset;
+    std::uint64_t symbol_table_size;
+    std::uint64_t column_offset[kColumns];
+    std::uint8_t reserved[24];
+};
+static_assert(sizeof(TickFileHeader) == 128, "tick file header is 128 bytes on disk");
+
+// Rows [begin, end) of a columnar tick file
+struct RowRange {
+    std::uint64_t begin = 0;
+    std::uint64_t end = 0;
+};
+
+// Read-only, memory-mapped columnar tick file. Columns are used in place:
+// opening costs a header and symbol-table check, and ticks are paged in on
+// first touch and shared through the page cache with other processes.
+class ColumnarTickFile {
+public:
+    // A symbol's rows: contiguous and time-sorted
+    struct SymbolRange {
+        std::string name;
+        std::uint64_t first_row = 0;
+        std::uint64_t row_count = 0;
+    };
+
+    // Map and validate 'path'; nullptr (with an error on stderr) if it is not a valid tick file
+    static std::shared_ptr<const ColumnarTickFile> open(const std::string& path);
+
+    // True if 'path' starts with the tick file magic
+    static bool isTickFile(const std::string& path);
+
+    // Write one or more symbols' time-sorted ticks as a tick file. Fails (with
+    // an error on stderr, before creating the file) if a series is not sorted
+    // by timestamp: filtered loads binary search the timestamp column.
+    static bool write(const std::string& path,
+                      const std::vector<std::pair<std::string, std::span<const Tick>>>& series);
+
+    std::uint64_t rows() const { return rows_; }
+    const std::vector<SymbolRange>& symbols() const { return symbols_; }
+
+    // Range stored under 'name', or nullptr
+    const SymbolRange* findSymbol(std::string_view name) const;
+
+    // Non-empty row ranges of 'range' that pass 'filter', in order. Binary
+    // searches the timestamp column (two per session day); no other column is read.
+    std::vector<RowRange> selectRows(const SymbolRange& range, const TickFilter& filter) const;
+
+    std::span<const std::int64_t> timestamps() const { return {timestamps_, rows_}; }
+    std::span<const double> prices() const { return {prices_, rows_}; }
+    std::span<const std::int64_t> volumes() const { return {volumes_, rows_}; }
+    std::span<const double> bidSizes() const { return {bid_sizes_, rows_}; }
+    std::span<const double> askSizes() const { return {ask_sizes_, rows_}; }
+    std::span<const double> highs() const { return {highs_, rows_}; }
+    std::span<const double> lows() const { return {lows_, rows_}; }
+
+    // Assemble row 'row' as a Tick
+    void readTick(std::size_t row, SymbolId symbol, Tick& out) const;
+
+private:
+    ColumnarTickFile() = default;
+
+    MappedFile file_;
+    std::uint64_t rows_ = 0;
+    std::vector<SymbolRange> symbols_;
+    const std::int64_t* timestamps_ = nullptr;
+    const double* prices_ = nullptr;
+    const std::int64_t* volumes_ = nullptr;
+    const double* bid_sizes_ = nullptr;
+    const double* ask_sizes_ = nullptr;
+    const double* highs_ = nullptr;
+    const double* lows_ = nullptr;
+};
+
+using TickFilePtr = std::shared_ptr<const ColumnarTickFile>;
+
+// Cursor over one symbol's rows of a columnar tick file, or over selected row
+// ranges of it. Ticks are assembled from the mapped columns one at a time;
+// nothing is copied up front.
+class ColumnarTickSource : public TickSource {
+public:
+    ColumnarTickSource(TickFilePtr file, std::uint64_t first_row, std::uint64_t row_count, SymbolId symbol)
+        : ColumnarTickSource(std::move(file), std::vector<RowRange>{{first_row, first_row + row_count}}, symbol) {}
+
+    ColumnarTickSource(TickFilePtr file, std::vector<RowRange> ranges, SymbolId symbol)
+        : file_(std::move(file)), ranges_(std::move(ranges)) {
+        tick_.symbol_id = symbol;
+        rewind();
+    }
+
+    const Tick* peek() override {
+        if (pos_ >= end_) return nullptr;
+        if (loaded_ != pos_) {
+            file_->readTick(pos_, tick_.symbol_id, tick_);
+            loaded_ = pos_;
+        }
+        return &tick_;
+    }
+
+    void advance() override {
+        if (++pos_ == end_ && range_ + 1 < ranges_.size()) {
+            ++range_;
+            pos_ = ranges_[range_].begin;
+            end_ = ranges_[range_].end;
+        }
+    }
+
+    bool rewind() override {
+        range_ = 0;
+        pos_ = ranges_.empty() ? 0 : ranges_[0].begin;
+        end_ = ranges_.empty() ? 0 : ranges_[0].end;
+        return true;
+    }
+
+    // write() refuses unsorted series
+    bool isSorted() const override { return true; }
+
+private:
+    TickFilePtr file_;
+    std::vector<RowRange> ranges_;
+    std::size_t range_ = 0;
+    std::uint64_t end_ = 0;
+    std::uint64_t pos_ = 0;
+    std::uint64_t loaded_ = std::numeric_limits<std::uint64_t>::max();
+    Tick tick_{};
+};
+
+// Stable-sort a series by timestamp, as the tick file writers require; rows
+// with equal timestamps keep their order. Returns the number of rows that
+// were earlier than the row before them.
+std::size_t sortByTimestamp(std::vector<Tick>& ticks);
+
+// Error on stderr naming the first series that is not sorted by timestamp
+bool allSortedByTimestamp(const std::string& path,
+                          const std::vector<std::pair<std::string, std::span<const Tick>>>& series);
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+
+namespace AlgoCatalyst {
+
+// Which ticks a load keeps: a time window [start_us, end_us) and an optional
+// intraday session [session_open_utc_s, session_close_utc_s) in UTC seconds
+// of day. Loaders apply it below the tick level where they can (row ranges of
+// a columnar file, whole blocks of a compressed one), so ticks outside it are
+// never materialised. The default keeps everything.
+struct TickFilter {
+    static constexpr std::int64_t kUsPerDay = 86'400'000'000LL;
+    static constexpr std::int64_t kSecondsPerDay = 86'400;
+
+    std::int64_t start_us = std::numeric_limits<std::int64_t>::min();   // Inclusive
+    std::int64_t end_us = std::numeric_limits<std::int64_t>::max();     // Exclusive
+    std::int64_t session_open_utc_s = 0;                                // Inclusive
+    std::int64_t session_close_utc_s = kSecondsPerDay;                  // Exclusive; must be > open
+
+    bool hasWindow() const {
+        return start_us != std::numeric_limits<std::int64_t>::min() ||
+               end_us != std::numeric_limits<std::int64_t>::max();
+    }
+    bool hasSession() const { return session_open_utc_s > 0 || session_close_utc_s < kSecondsPerDay; }
+    bool passesAll() const { return !hasWindow() && !hasSession(); }
+
+    bool contains(std::int64_t ts) const {
+        if (ts < start_us || ts >= end_us) return false;
+        if (!hasSession()) return true;
+        std::int64_t us_of_day = ts - dayStart(ts);
+        return us_of_day >= session_open_utc_s * 1'000'000LL && us_of_day < session_close_utc_s * 1'000'000LL;
+    }
+
+    // Smallest timestamp >= ts that passes, or end_us if none does
+    std::int64_t nextInside(std::int64_t ts) const {
+        if (ts < start_us) ts = start_us;
+        if (ts >= end_us || !hasSession()) return ts >= end_us ? end_us : ts;
+        const std::int64_t day = dayStart(ts);
+        const std::int64_t open = day + session_open_utc_s * 1'000'000LL;
+        const std::int64_t close = day + session_close_utc_s * 1'000'000LL;
+        std::int64_t next = ts < open ? open : (ts < close ? ts : open + kUsPerDay);
+        return next < end_us ? next : end_us;
+    }
+
+    // End (exclusive) of the passing stretch that holds ts; ts must pass
+    std::int64_t insideUntil(std::int64_t ts) const {
+        if (!hasSession()) return end_us;
+        std::int64_t close = dayStart(ts) + session_close_utc_s * 1'000'000LL;
+        return close < end_us ? close : end_us;
+    }
+
+    auto operator<=>(const TickFilter&) const = default;
+
+private:
+    static std::int64_t dayStart(std::int64_t ts) {
+        std::int64_t day = ts / kUsPerDay;
+        if (ts % kUsPerDay < 0) --day;
+        return day * kUsPerDay;
+    }
+};
+
+} // namespace AlgoCatalyst
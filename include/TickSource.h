@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include "Events.h"
+
+namespace AlgoCatalyst {
+
+// Pull cursor over one symbol's ticks in timestamp order. The Backtester merges
+// one cursor per symbol k-way by timestamp instead of queueing every tick.
+class TickSource {
+public:
+    virtual ~TickSource() = default;
+
+    // Next tick without consuming it, or nullptr once exhausted. The pointer is
+    // only valid until the next call to advance().
+    virtual const Tick* peek() = 0;
+
+    // Consume the tick returned by peek()
+    virtual void advance() = 0;
+
+    // Restart from the first tick for another run; false if the source cannot
+    virtual bool rewind() { return false; }
+
+    // True if the ticks are known to be in timestamp order (false when that
+    // cannot be told up front). The Backtester picks its scheduler from this.
+    virtual bool isSorted() const { return false; }
+};
+
+// Cursor over a series that is never held in memory as a whole (compressed
+// blocks, a streamed CSV). The engine cannot look fills up ahead of time, so it
+// asks the source when a fill fires: by then every tick before the fill time
+// has been consumed and none after it, so the answer is the stream head or one
+// of the ticks consumed last.
+class StreamedTickSource : public TickSource {
+public:
+    // First tick with timestamp >= ts without moving the cursor; nullptr past the end
+    virtual const Tick* firstAtOrAfter(std::int64_t ts) = 0;
+};
+
+// Cursor over ticks already held in memory (the storage must outlive the source)
+class VectorTickSource : public TickSource {
+public:
+    explicit VectorTickSource(std::span<const Tick> ticks) : ticks_(ticks) {}
+
+    const Tick* peek() override {
+        return pos_ < ticks_.size() ? &ticks_[pos_] : nullptr;
+    }
+
+    void advance() override { ++pos_; }
+
+    bool rewind() override {
+        pos_ = 0;
+        return true;
+    }
+
+    // Scans the ticks on the first call
+    bool isSorted() const override {
+        if (sorted_ < 0) {
+            sorted_ = std::is_sorted(ticks_.begin(), ticks_.end(), [](const Tick& a, const Tick& b) {
+                return a.timestamp_us < b.timestamp_us;
+            });
+        }
+        return sorted_ > 0;
+    }
+
+private:
+    std::span<const Tick> ticks_;
+    std::size_t pos_ = 0;
+    mutable int sorted_ = -1;
+};
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Events.h"
+#include "TickCache.h"
+#include "TickFilter.h"
+
+namespace AlgoCatalyst {
+
+// Immutable, reference-counted tick series. Backtesters, shards and repeated
+// runs share one copy; nothing may modify the ticks once published.
+using TickSeriesPtr = std::shared_ptr<const std::vector<Tick>>;
+
+// Process-wide cache of parsed tick files keyed by (path, symbol, filter), so loading
+// the same CSV for another Backtester or parameter set costs a lookup instead
+// of a re-parse. Thread-safe. Entries stay cached until evicted or cleared;
+// a file changed on disk is not re-read until then.
+class TickStore {
+public:
+    static TickStore& global();
+
+    // Series for the CSV at 'path' with every tick stamped with 'symbol',
+    // keeping only ticks that pass 'filter'; parses on first use. nullptr if
+    // no ticks remain.
+    TickSeriesPtr load(const std::string& path, const std::string& symbol, const TickFilter& filter = {});
+
+    // Publish ticks already in memory as a shared series for 'symbol'
+    static TickSeriesPtr adopt(std::vector<Tick> ticks, SymbolId symbol);
+
+    // Drop one cached file (under every filter) / everything. Series still
+    // referenced stay alive.
+    void evict(const std::string& path, const std::string& symbol);
+    void clear();
+
+    std::size_t size() const;
+
+    // Side-car cache mode for the CSVs this store parses (default Off)
+    void setCacheMode(TickCacheMode mode);
+    TickCacheMode cacheMode() const;
+
+private:
+    struct Key {
+        std::string path;
+        SymbolId symbol;
+        TickFilter filter;
+        auto operator<=>(const Key&) const = default;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<Key, TickSeriesPtr> series_;
+    TickCacheMode cache_mode_ = TickCacheMode::Off;
+};
+
+} // namespace AlgoCatalyst
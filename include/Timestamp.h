@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+
+namespace AlgoCatalyst {
+
+// Days from 1970-01-01 to y-m-d in the proleptic Gregorian calendar
+// (H. Hinnant's days_from_civil; no tables, no time zone)
+constexpr std::int64_t daysFromCivil(std::int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const std::int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);                // [0, 399]
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;     // [0, 365]
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;               // [0, 146096]
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+constexpr bool isLeapYear(std::int64_t y) {
+    return y % 4 == 0 && (y % 100 != 0 || y % 400 == 0);
+}
+
+constexpr unsigned daysInMonth(std::int64_t y, unsigned m) {
+    constexpr unsigned kDays[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return m == 2 && isLeapYear(y) ? 29 : kDays[m - 1];
+}
+
+// Allocation-free UTC parser for tick timestamps: integer microseconds, or
+// ISO 8601 "YYYY-MM-DD[T ]HH:MM:SS[.ffffff][Z|+HH:MM|-HH:MM]". Fractions
+// beyond microseconds are truncated. The date is parsed once per run of rows
+// from the same day: rows whose first ten bytes match the previous ISO
+// timestamp reuse its day. Not thread-safe; use one per thread.
+class TimestampParser {
+public:
+    // Microseconds since the epoch; 0 if 'text' is not a valid timestamp
+    std::int64_t parse(std::string_view text) {
+        if (text.empty()) return 0;
+        if (isDigit(text[0]) && (text.size() < 5 || text[4] != '-')) return parseInteger(text);
+        return parseIso(text);
+    }
+
+private:
+    static constexpr std::int64_t kUsPerSecond = 1'000'000LL;
+
+    static bool isDigit(char c) { return static_cast<unsigned>(c - '0') < 10; }
+
+    // Exactly 'n' digits at p
+    static bool digits(const char* p, int n, unsigned& out) {
+        unsigned v = 0;
+        for (int i = 0; i < n; ++i) {
+            if (!isDigit(p[i])) return false;
+            v = v * 10 + static_cast<unsigned>(p[i] - '0');
+        }
+        out = v;
+        return true;
+    }
+
+    static std::int64_t parseInteger(std::string_view text) {
+        std::int64_t value = 0;
+        for (char c : text) {
+            if (!isDigit(c) || value > (std::numeric_limits<std::int64_t>::max() - 9) / 10) return 0;
+            value = value * 10 + (c - '0');
+        }
+        return value;
+    }
+
+    // Microseconds at midnight of the "YYYY-MM-DD" at p; false if not a valid date
+    static bool parseDate(const char* p, std::int64_t& day_us) {
+        unsigned y, m, d;
+        if (!digits(p, 4, y) || p[4] != '-' || !digits(p + 5, 2, m) || p[7] != '-' || !digits(p + 8, 2, d)) {
+            return false;
+        }
+        if (m < 1 || m > 12 || d < 1 || d > daysInMonth(y, m)) return false;
+        day_us = daysFromCivil(y, m, d) * 86'400LL * kUsPerSecond;
+        return true;
+    }
+
+    std::int64_t parseIso(std::string_view text) {
+        const char* p = text.data();
+        const std::size_t n = text.size();
+        if (n < 19) return 0;
+
+        if (!cached_ || std::memcmp(p, date_, sizeof(date_)) != 0) {
+            cached_ = parseDate(p, day_us_);
+            if (!cached_) return 0;
+            std::memcpy(date_, p, sizeof(date_));
+        }
+
+        unsigned hh, mm, ss;
+        if ((p[10] != 'T' && p[10] != ' ') || !digits(p + 11, 2, hh) || p[13] != ':' ||
+            !digits(p + 14, 2, mm) || p[16] != ':' || !digits(p + 17, 2, ss)) {
+            return 0;
+        }
+        if (hh > 23 || mm > 59 || ss > 60) return 0;   // 60: leap second, rolls into the next minute
+        std::int64_t us = day_us_ + ((hh * 60 + mm) * 60 + ss) * kUsPerSecond;
+
+        std::size_t i = 19;
+        if (i < n && (p[i] == '.' || p[i] == ',')) {
+            ++i;
+            std::size_t start = i;
+            std::int64_t frac = 0;
+            int kept = 0;
+            for (; i < n && isDigit(p[i]); ++i) {
+                if (kept < 6) {
+                    frac = frac * 10 + (p[i] - '0');
+                    ++kept;
+                }
+            }
+            if (i == start) return 0;
+            for (; kept < 6; ++kept) frac *= 10;
+            us += frac;
+        }
+
+        if (i < n && p[i] == 'Z') {
+            ++i;
+        } else if (i < n && (p[i] == '+' || p[i] == '-')) {
+            // Offset from UTC: local = UTC + offset
+            unsigned oh, om;
+            const bool colon = i + 3 < n && p[i + 3] == ':';
+            if (n - i != (colon ? 6u : 5u) || !digits(p + i + 1, 2, oh) || !digits(p + i + (colon ? 4 : 3), 2, om) ||
+                oh > 23 || om > 59) {
+                return 0;
+            }
+            std::int64_t offset = (oh * 60 + om) * 60 * kUsPerSecond;
+            us += p[i] == '+' ? -offset : offset;
+            i = n;
+        }
+        return i == n ? us : 0;
+    }
+
+    char date_[10] = {};
+    std::int64_t day_us_ = 0;
+    bool cached_ = false;
+};
+
+} // namespace AlgoCatalyst
@@ -8,6 +8,9 @@ and ranks results by Sharpe ratio (or any other metric you choose).
 Usage:
     python3 scripts/optimize_params.py --scenario catalyst --ticks 10000 \
         --metric sharpe --top 10
+
+Pass --native to run the whole grid inside one process via
+`AlgoCatalyst sweep` instead of launching the binary once per combination.
 """
 
 import argparse
@@ -78,6 +81,50 @@ def run_backtest(data_file: Path, trades_file: Path,
     return metrics
 
 
+def run_native_sweep(data_file: Path, stop_loss_values, take_profit_values,
+                     trailing_values, slippage_values, threads: int) -> list:
+    """Run the grid through `AlgoCatalyst sweep` and read back its results CSV."""
+    if not BINARY.exists():
+        return []
+
+    out_csv = DATA_DIR / "_opt_sweep_tmp.csv"
+    join = lambda values: ",".join(str(v) for v in values)
+    result = subprocess.run(
+        [str(BINARY), "sweep",
+         "--data", str(data_file),
+         "--symbol", "OPT",
+         "--stop-loss",   join(stop_loss_values),
+         "--take-profit", join(take_profit_values),
+         "--trailing",    join(trailing_values),
+         "--slippage",    join(slippage_values),
+         "--threads",     str(threads),
+         "--top", "0",
+         "--output", str(out_csv)],
+        capture_output=True, text=True
+    )
+    if result.returncode != 0 or not out_csv.exists():
+        print(result.stderr, file=sys.stderr)
+        return []
+
+    results = []
+    with open(out_csv, newline="") as f:
+        for row in csv.DictReader(f):
+            results.append({
+                "stop_loss":     float(row["stop_loss"]),
+                "take_profit":   float(row["take_profit"]),
+                "trailing":      float(row["trailing"]),
+                "slippage":      float(row["slippage"]),
+                "pnl":           float(row["pnl"]),
+                "win_rate":      float(row["win_rate"]),
+                "profit_factor": float(row["profit_factor"]),
+                "sharpe":        float(row["sharpe"]),
+                "max_dd":        float(row["max_dd"]),
+                "num_trades":    float(row["num_trades"]),
+            })
+    out_csv.unlink()
+    return results
+
+
 def main():
     parser = argparse.ArgumentParser(description="Parameter sweep optimizer")
     parser.add_argument("--scenario", default="catalyst",
@@ -87,6 +134,10 @@ def main():
                         choices=["sharpe", "pnl", "profit_factor", "win_rate"])
     parser.add_argument("--top", type=int, default=10,
                         help="Show top N parameter combos")
+    parser.add_argument("--native", action="store_true",
+                        help="Run the grid in-process via 'AlgoCatalyst sweep'")
+    parser.add_argument("--threads", type=int, default=0,
+                        help="Worker threads for --native (0 = all cores)")
     args = parser.parse_args()
 
     data_file = DATA_DIR / f"opt_{args.scenario}.csv"
@@ -105,19 +156,23 @@ def main():
           f"(scenario={args.scenario}, metric={args.metric})...")
 
     results = []
-    tmp_trades = DATA_DIR / "_opt_trades_tmp.csv"
-
-    for i, (sl, tp, tr, slip) in enumerate(combos):
-        if tp <= sl:
-            continue
-        m = run_backtest(data_file, tmp_trades, sl, tp, tr, slip)
-        if m:
-            results.append(m)
-        if (i + 1) % 20 == 0:
-            print(f"  {i+1}/{len(combos)} done...")
-
-    if tmp_trades.exists():
-        tmp_trades.unlink()
+    if args.native:
+        results = run_native_sweep(data_file, stop_loss_values, take_profit_values,
+                                   trailing_values, slippage_values, args.threads)
+    else:
+        tmp_trades = DATA_DIR / "_opt_trades_tmp.csv"
+
+        for i, (sl, tp, tr, slip) in enumerate(combos):
+            if tp <= sl:
+                continue
+            m = run_backtest(data_file, tmp_trades, sl, tp, tr, slip)
+            if m:
+                results.append(m)
+            if (i + 1) % 20 == 0:
+                print(f"  {i+1}/{len(combos)} done...")
+
+        if tmp_trades.exists():
+            tmp_trades.unlink()
 
     if not results:
         print("[ERROR] No results. Is the binary built?")
@@ -8,14 +8,20 @@
 namespace AlgoCatalyst {
 
 RegimeClassifier::RegimeClassifier(std::size_t lookback, std::size_t num_clusters)
-    : lookback_(lookback), num_clusters_(num_clusters), 
+    : tick_history_(lookback + 1), lookback_(lookback), num_clusters_(num_clusters), 
       current_regime_(Regime::CHOPPY) {
     // Initialize centroids
     centroids_.resize(num_clusters_);
 }
 
+void RegimeClassifier::reset() {
+    tick_history_.clear();
+    current_regime_ = Regime::CHOPPY;
+    centroids_.assign(num_clusters_, Feature{});
+}
+
 RegimeClassifier::Regime RegimeClassifier::updateAndClassify(const Tick& tick) {
-    tick_history_.push_back(tick);
+    tick_history_.push_back({tick.price, tick.volume});
     
     // Keep only last 'lookback' ticks
     if (tick_history_.size() > lookback_) {
@@ -37,8 +43,8 @@ RegimeClassifier::Regime RegimeClassifier::updateAndClassify(const Tick& tick) {
     // Classify current tick's feature
     Feature current_feature;
     if (tick_history_.size() >= 2) {
-        current_feature.volatility = calculateVolatility(tick_history_);
-        current_feature.direction = calculateDirection(tick_history_);
+        current_feature.volatility = calculateVolatility(tick_history_.begin(), tick_history_.end());
+        current_feature.direction = calculateDirection(tick_history_.begin(), tick_history_.end());
         
         // Normalize volume (use recent average)
         std::int64_t sum_vol = 0;
@@ -168,7 +174,7 @@ void RegimeClassifier::performKMeans(const std::vector<Feature>& features) {
     }
 }
 
-std::vector<RegimeClassifier::Feature> RegimeClassifier::extractFeatures(const std::deque<Tick>& ticks) {
+std::vector<RegimeClassifier::Feature> RegimeClassifier::extractFeatures(const History& ticks) {
     std::vector<Feature> features;
     
     if (ticks.size() < 2) return features;
@@ -179,19 +185,20 @@ std::vector<RegimeClassifier::Feature> RegimeClassifier::extractFeatures(const s
     for (std::size_t i = window_size; i < ticks.size(); ++i) {
         Feature f;
         
-        // Create window
-        std::deque<Tick> window(ticks.begin() + (i - window_size), ticks.begin() + i + 1);
+        // Window [i - window_size, i], read in place
+        HistoryIt first = ticks.begin() + (i - window_size);
+        HistoryIt last = ticks.begin() + i + 1;
         
-        f.volatility = calculateVolatility(window);
-        f.direction = calculateDirection(window);
+        f.volatility = calculateVolatility(first, last);
+        f.direction = calculateDirection(first, last);
         
         // Normalize volume
         std::int64_t sum_vol = 0;
-        for (const auto& t : window) {
-            sum_vol += t.volume;
+        for (HistoryIt t = first; t != last; ++t) {
+            sum_vol += t->volume;
         }
-        double avg_vol = sum_vol > 0 ? static_cast<double>(sum_vol) / window.size() : 1.0;
-        f.volume_norm = static_cast<double>(window.back().volume) / avg_vol;
+        double avg_vol = sum_vol > 0 ? static_cast<double>(sum_vol) / (window_size + 1) : 1.0;
+        f.volume_norm = static_cast<double>(ticks[i].volume) / avg_vol;
         
         features.push_back(f);
     }
@@ -199,8 +206,8 @@ std::vector<RegimeClassifier::Feature> RegimeClassifier::extractFeatures(const s
     // If no features extracted, create one from entire history
     if (features.empty() && ticks.size() >= 2) {
         Feature f;
-        f.volatility = calculateVolatility(ticks);
-        f.direction = calculateDirection(ticks);
+        f.volatility = calculateVolatility(ticks.begin(), ticks.end());
+        f.direction = calculateDirection(ticks.begin(), ticks.end());
         
         std::int64_t sum_vol = 0;
         for (const auto& t : ticks) {
@@ -243,14 +250,16 @@ RegimeClassifier::Feature RegimeClassifier::calculateCentroid(const std::vector<
     return centroid;
 }
 
-double RegimeClassifier::calculateVolatility(const std::deque<Tick>& ticks) {
-    if (ticks.size() < 2) return 0.0;
+double RegimeClassifier::calculateVolatility(HistoryIt first, HistoryIt last) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    if (n < 2) return 0.0;
     
     // Calculate returns
     std::vector<double> returns;
-    for (std::size_t i = 1; i < ticks.size(); ++i) {
-        if (ticks[i-1].price > 0.0) {
-            double ret = (ticks[i].price - ticks[i-1].price) / ticks[i-1].price;
+    returns.reserve(n - 1);
+    for (std::size_t i = 1; i < n; ++i) {
+        if (first[i-1].price > 0.0) {
+            double ret = (first[i].price - first[i-1].price) / first[i-1].price;
             returns.push_back(ret);
         }
     }
@@ -271,19 +280,20 @@ double RegimeClassifier::calculateVolatility(const std::deque<Tick>& ticks) {
     return std::sqrt(variance);
 }
 
-double RegimeClassifier::calculateDirection(const std::deque<Tick>& ticks) {
-    if (ticks.size() < 2) return 0.0;
+double RegimeClassifier::calculateDirection(HistoryIt first, HistoryIt last) {
+    const std::size_t n = static_cast<std::size_t>(last - first);
+    if (n < 2) return 0.0;
     
     // Calculate net directional movement
     double total_move = 0.0;
-    for (std::size_t i = 1; i < ticks.size(); ++i) {
-        if (ticks[i-1].price > 0.0) {
-            double change = (ticks[i].price - ticks[i-1].price) / ticks[i-1].price;
+    for (std::size_t i = 1; i < n; ++i) {
+        if (first[i-1].price > 0.0) {
+            double change = (first[i].price - first[i-1].price) / first[i-1].price;
             total_move += change;
         }
     }
     
-    return std::abs(total_move) / ticks.size();  // Normalized directional strength
+    return std::abs(total_move) / n;  // Normalized directional strength
 }
 
 } // namespace AlgoCatalyst
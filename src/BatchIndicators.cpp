@@ -0,0 +1,407 @@
+#include "BatchIndicators.h"
+#include "FixedIndicators.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define ALGOCATALYST_AVX2_KERNELS 1
+#include <immintrin.h>
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+namespace AlgoCatalyst {
+
+namespace {
+
+// Recurrences run over the column in chunks this long, so every pass over a
+// chunk finds it in cache
+constexpr std::size_t kChunk = 2048;
+// Window sums restart from an exact sum this often (or every period, if longer)
+constexpr std::size_t kBollingerBlock = 4096;
+// Bound on the relative rounding one scan step adds to a running sum
+constexpr double kScanRounding = 8.0 * std::numeric_limits<double>::epsilon();
+
+bool cpuHasAvx2() {
+#ifdef ALGOCATALYST_AVX2_KERNELS
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+    return false;
+#endif
+}
+
+std::atomic<bool> g_simd{cpuHasAvx2()};
+
+void requireLength(const char* name, std::size_t have, std::size_t need) {
+    if (have < need) {
+        throw std::invalid_argument(std::string("BatchIndicators::") + name + ": output shorter than input");
+    }
+}
+
+void requirePeriod(const char* name, std::size_t period) {
+    if (period == 0) throw std::invalid_argument(std::string("BatchIndicators::") + name + ": period must be positive");
+}
+
+// ── Scan: y[t] = y[t] + c * y[t-1] in place, y[-1] = carry ──────────────────
+// Returns the last y, the carry into the next chunk.
+double scanScalar(double* y, std::size_t n, double c, double carry) {
+    for (std::size_t i = 0; i < n; ++i) carry = y[i] = y[i] + c * carry;
+    return carry;
+}
+
+#ifdef ALGOCATALYST_AVX2_KERNELS
+AVX2_TARGET double scanAvx2(double* y, std::size_t n, double c, double carry) {
+    const double c2 = c * c;
+    const __m256d c1v = _mm256_set1_pd(c);
+    const __m256d c2v = _mm256_set1_pd(c2);
+    const __m256d c4v = _mm256_set1_pd(c2 * c2);
+    const __m256d powers = _mm256_setr_pd(c, c2, c2 * c, c2 * c2);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d carry_v = _mm256_set1_pd(carry);
+
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        // Scan the four values in-register (log-step: shift by 1, then by 2)
+        __m256d v = _mm256_loadu_pd(y + i);
+        __m256d shifted = _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0b0001);
+        v = _mm256_fmadd_pd(c1v, shifted, v);
+        shifted = _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0b0011);
+        v = _mm256_fmadd_pd(c2v, shifted, v);
+        // Fold in the carry: lane k gets c^(k+1) * carry. Only the carry update is serial.
+        _mm256_storeu_pd(y + i, _mm256_fmadd_pd(powers, carry_v, v));
+        carry_v = _mm256_fmadd_pd(c4v, carry_v, _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3)));
+    }
+    return scanScalar(y + i, n - i, c, _mm256_cvtsd_f64(carry_v));
+}
+#endif
+
+// ── Bollinger window kernels ────────────────────────────────────────────────
+// Window sums run as scans of what enters minus what leaves: d[t] = x[t] - x[t-p]
+// for the sum, and the sliding Welford term for the sum of squared deviations
+// (M2), which is exactly 0 wherever the price did not move.
+void windowDeltasScalar(const double* x, std::size_t p, double* d, std::size_t first, std::size_t last) {
+    for (std::size_t t = first; t < last; ++t) d[t] = x[t] - x[t - p];
+}
+
+// Offset sums s (of x - k) to means, in place
+void meansScalar(std::size_t p, double k, double* s, std::size_t first, std::size_t last) {
+    const double inv_p = 1.0 / static_cast<double>(p);
+    for (std::size_t t = first; t < last; ++t) s[t] = k + s[t] * inv_p;
+}
+
+// M2[t] - M2[t-1] = (x[t] - x[t-p]) * ((x[t] - mean[t]) + (x[t-p] - mean[t-1]))
+void m2DeltasScalar(const double* x, std::size_t p, const double* mean, double* dm2, std::size_t first,
+                    std::size_t last) {
+    for (std::size_t t = first; t < last; ++t) {
+        double in = x[t], out = x[t - p];
+        dm2[t] = (in - out) * ((in - mean[t]) + (out - mean[t - 1]));
+    }
+}
+
+// 'upper' holds M2 and 'middle' the mean on entry
+void bandsScalar(std::size_t p, double mult, double* upper, const double* middle, double* lower,
+                 std::size_t first, std::size_t last) {
+    const double inv_p = 1.0 / static_cast<double>(p);
+    for (std::size_t t = first; t < last; ++t) {
+        double width = mult * std::sqrt(std::max(upper[t] * inv_p, 0.0));
+        upper[t] = middle[t] + width;
+        lower[t] = middle[t] - width;
+    }
+}
+
+// Largest value in [first, last)
+double peakScalar(const double* y, std::size_t first, std::size_t last) {
+    double peak = 0.0;
+    for (std::size_t t = first; t < last; ++t) peak = std::max(peak, y[t]);
+    return peak;
+}
+
+#ifdef ALGOCATALYST_AVX2_KERNELS
+AVX2_TARGET void windowDeltasAvx2(const double* x, std::size_t p, double* d, std::size_t first, std::size_t last) {
+    std::size_t t = first;
+    for (; t + 4 <= last; t += 4) {
+        _mm256_storeu_pd(d + t, _mm256_sub_pd(_mm256_loadu_pd(x + t), _mm256_loadu_pd(x + t - p)));
+    }
+    windowDeltasScalar(x, p, d, t, last);
+}
+
+AVX2_TARGET void meansAvx2(std::size_t p, double k, double* s, std::size_t first, std::size_t last) {
+    const __m256d inv_p = _mm256_set1_pd(1.0 / static_cast<double>(p));
+    const __m256d kv = _mm256_set1_pd(k);
+    std::size_t t = first;
+    for (; t + 4 <= last; t += 4) {
+        _mm256_storeu_pd(s + t, _mm256_add_pd(kv, _mm256_mul_pd(_mm256_loadu_pd(s + t), inv_p)));
+    }
+    meansScalar(p, k, s, t, last);
+}
+
+AVX2_TARGET void m2DeltasAvx2(const double* x, std::size_t p, const double* mean, double* dm2, std::size_t first,
+                              std::size_t last) {
+    std::size_t t = first;
+    for (; t + 4 <= last; t += 4) {
+        __m256d in = _mm256_loadu_pd(x + t);
+        __m256d out = _mm256_loadu_pd(x + t - p);
+        __m256d dev = _mm256_add_pd(_mm256_sub_pd(in, _mm256_loadu_pd(mean + t)),
+                                    _mm256_sub_pd(out, _mm256_loadu_pd(mean + t - 1)));
+        _mm256_storeu_pd(dm2 + t, _mm256_mul_pd(_mm256_sub_pd(in, out), dev));
+    }
+    m2DeltasScalar(x, p, mean, dm2, t, last);
+}
+
+AVX2_TARGET void bandsAvx2(std::size_t p, double mult, double* upper, const double* middle, double* lower,
+                           std::size_t first, std::size_t last) {
+    const __m256d inv_p = _mm256_set1_pd(1.0 / static_cast<double>(p));
+    const __m256d mv = _mm256_set1_pd(mult);
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t t = first;
+    for (; t + 4 <= last; t += 4) {
+        __m256d var = _mm256_max_pd(_mm256_mul_pd(_mm256_loadu_pd(upper + t), inv_p), zero);
+        __m256d width = _mm256_mul_pd(mv, _mm256_sqrt_pd(var));
+        __m256d mid = _mm256_loadu_pd(middle + t);
+        _mm256_storeu_pd(upper + t, _mm256_add_pd(mid, width));
+        _mm256_storeu_pd(lower + t, _mm256_sub_pd(mid, width));
+    }
+    bandsScalar(p, mult, upper, middle, lower, t, last);
+}
+
+AVX2_TARGET double peakAvx2(const double* y, std::size_t first, std::size_t last) {
+    __m256d peak_v = _mm256_setzero_pd();
+    std::size_t t = first;
+    for (; t + 4 <= last; t += 4) peak_v = _mm256_max_pd(peak_v, _mm256_loadu_pd(y + t));
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, peak_v);
+    double peak = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+    return std::max(peak, peakScalar(y, t, last));
+}
+#endif
+
+// One set of kernels or the other, chosen per call from the SIMD switch
+struct Kernels {
+    double (*scan)(double*, std::size_t, double, double);
+    void (*windowDeltas)(const double*, std::size_t, double*, std::size_t, std::size_t);
+    void (*means)(std::size_t, double, double*, std::size_t, std::size_t);
+    void (*m2Deltas)(const double*, std::size_t, const double*, double*, std::size_t, std::size_t);
+    void (*bands)(std::size_t, double, double*, const double*, double*, std::size_t, std::size_t);
+    double (*peak)(const double*, std::size_t, std::size_t);
+};
+
+constexpr Kernels kScalarKernels{scanScalar, windowDeltasScalar, meansScalar, m2DeltasScalar, bandsScalar,
+                                    peakScalar};
+#ifdef ALGOCATALYST_AVX2_KERNELS
+constexpr Kernels kAvx2Kernels{scanAvx2, windowDeltasAvx2, meansAvx2, m2DeltasAvx2, bandsAvx2, peakAvx2};
+#endif
+
+const Kernels& kernels() {
+#ifdef ALGOCATALYST_AVX2_KERNELS
+    if (g_simd.load(std::memory_order_relaxed)) return kAvx2Kernels;
+#endif
+    return kScalarKernels;
+}
+
+} // namespace
+
+bool BatchIndicators::simdEnabled() { return g_simd.load(); }
+
+void BatchIndicators::setSimdEnabled(bool enabled) { g_simd.store(enabled && cpuHasAvx2()); }
+
+void BatchIndicators::ema(std::span<const double> prices, std::size_t period, std::span<double> out) {
+    requirePeriod("ema", period);
+    requireLength("ema", out.size(), prices.size());
+    const std::size_t n = prices.size();
+    const std::size_t warm = std::min(n, period);
+
+    EMAState state;
+    for (std::size_t i = 0; i < warm; ++i) {
+        state.update(prices[i], period);
+        out[i] = state.get(period);
+    }
+
+    const Kernels& kernel = kernels();
+    const double alpha = 2.0 / (period + 1.0);
+    double carry = state.value;
+    for (std::size_t begin = warm; begin < n; begin += kChunk) {
+        const std::size_t end = std::min(n, begin + kChunk);
+        for (std::size_t i = begin; i < end; ++i) out[i] = alpha * prices[i];
+        carry = kernel.scan(out.data() + begin, end - begin, 1.0 - alpha, carry);
+    }
+}
+
+void BatchIndicators::rsi(std::span<const double> prices, std::size_t period, std::span<double> out) {
+    requirePeriod("rsi", period);
+    requireLength("rsi", out.size(), prices.size());
+    const std::size_t n = prices.size();
+    const std::size_t warm = std::min(n, period);
+
+    RSIState state;
+    for (std::size_t i = 0; i < warm; ++i) {
+        state.update(prices[i], period);
+        out[i] = state.get(period);
+    }
+
+    // Wilder-smoothed gains in 'out', losses alongside
+    const Kernels& kernel = kernels();
+    const double alpha = 1.0 / period;
+    double avg_gain = state.avg_gain, avg_loss = state.avg_loss;
+    double losses[kChunk];
+    for (std::size_t begin = warm; begin < n; begin += kChunk) {
+        const std::size_t end = std::min(n, begin + kChunk);
+        for (std::size_t i = begin; i < end; ++i) {
+            double change = prices[i] - prices[i - 1];
+            out[i] = alpha * (change > 0.0 ? change : 0.0);
+            losses[i - begin] = alpha * (change < 0.0 ? -change : 0.0);
+        }
+        avg_gain = kernel.scan(out.data() + begin, end - begin, 1.0 - alpha, avg_gain);
+        avg_loss = kernel.scan(losses, end - begin, 1.0 - alpha, avg_loss);
+        for (std::size_t i = begin; i < end; ++i) {
+            double loss = losses[i - begin];
+            out[i] = loss == 0.0 ? 100.0 : 100.0 - (100.0 / (1.0 + out[i] / loss));
+        }
+    }
+}
+
+void BatchIndicators::bollinger(std::span<const double> prices, std::size_t period, double std_dev_mult,
+                                std::span<double> upper, std::span<double> middle, std::span<double> lower) {
+    requirePeriod("bollinger", period);
+    const std::size_t n = prices.size();
+    requireLength("bollinger", std::min({upper.size(), middle.size(), lower.size()}), n);
+
+    // Bands stay at zero until the first full window
+    const std::size_t first_full = std::min(n, period - 1);
+    std::fill_n(upper.begin(), first_full, 0.0);
+    std::fill_n(middle.begin(), first_full, 0.0);
+    std::fill_n(lower.begin(), first_full, 0.0);
+
+    // A one-price window has no spread
+    if (period == 1) {
+        std::copy(prices.begin(), prices.end(), upper.begin());
+        std::copy(prices.begin(), prices.end(), middle.begin());
+        std::copy(prices.begin(), prices.end(), lower.begin());
+        return;
+    }
+
+    const Kernels& kernel = kernels();
+    const double* x = prices.data();
+    const std::size_t block = std::max(kBollingerBlock, period);
+    for (std::size_t begin = first_full; begin < n; begin += block) {
+        const std::size_t end = std::min(n, begin + block);
+        const std::size_t count = end - begin - 1;
+
+        // Each block starts from exact window sums. The running sum is of
+        // x - k, with k a price inside the window, so the mean keeps its low
+        // digits instead of riding on the price level.
+        const double k = x[begin];
+        double s = 0.0;
+        for (std::size_t j = begin + 1 - period; j <= begin; ++j) s += x[j] - k;
+        middle[begin] = s;
+        kernel.windowDeltas(x, period, middle.data(), begin + 1, end);
+        kernel.scan(middle.data() + begin + 1, count, 1.0, s);
+        kernel.means(period, k, middle.data(), begin, end);
+
+        double m2 = 0.0;
+        for (std::size_t j = begin + 1 - period; j <= begin; ++j) {
+            double dev = x[j] - middle[begin];
+            m2 += dev * dev;
+        }
+        upper[begin] = m2;
+        kernel.m2Deltas(x, period, middle.data(), upper.data(), begin + 1, end);
+        kernel.scan(upper.data() + begin + 1, count, 1.0, m2);
+
+        // The scan leaves rounding of up to eps * steps * peak M2 behind,
+        // which the square root would turn into visible band width once the
+        // window goes quiet (a flat price). Windows that small are summed
+        // exactly; a window that only swapped a price for an equal one keeps
+        // its exact sum.
+        const double floor = kScanRounding * static_cast<double>(count) * kernel.peak(upper.data(), begin, end);
+        bool exact = true;
+        for (std::size_t t = begin + 1; t < end; ++t) {
+            if (upper[t] > floor) {
+                exact = false;
+                continue;
+            }
+            if (exact && x[t] == x[t - period]) {
+                upper[t] = upper[t - 1];
+                continue;
+            }
+            double sum = 0.0;
+            for (std::size_t j = t + 1 - period; j <= t; ++j) {
+                double dev = x[j] - middle[t];
+                sum += dev * dev;
+            }
+            upper[t] = sum;
+            exact = true;
+        }
+        kernel.bands(period, std_dev_mult, upper.data(), middle.data(), lower.data(), begin, end);
+    }
+}
+
+void BatchIndicators::atr(std::span<const double> high, std::span<const double> low, std::span<const double> close,
+                          std::size_t period, std::span<double> out) {
+    requirePeriod("atr", period);
+    const std::size_t n = std::min({high.size(), low.size(), close.size()});
+    requireLength("atr", out.size(), n);
+    const std::size_t warm = std::min(n, period);
+
+    ATRState state;
+    for (std::size_t i = 0; i < warm; ++i) {
+        state.update(high[i], low[i], close[i], period);
+        out[i] = state.get(period);
+    }
+
+    // Wilder smoothing (atr * (p - 1) + tr) / p as tr / p + (p - 1) / p * atr
+    const Kernels& kernel = kernels();
+    const double inv_p = 1.0 / static_cast<double>(period);
+    double carry = state.atr;
+    for (std::size_t begin = warm; begin < n; begin += kChunk) {
+        const std::size_t end = std::min(n, begin + kChunk);
+        for (std::size_t i = begin; i < end; ++i) {
+            double prev_close = close[i - 1];
+            double tr = std::max({high[i] - low[i], std::abs(high[i] - prev_close), std::abs(low[i] - prev_close)});
+            out[i] = tr * inv_p;
+        }
+        carry = kernel.scan(out.data() + begin, end - begin, (period - 1.0) * inv_p, carry);
+    }
+}
+
+void BatchIndicators::macd(std::span<const double> prices, std::span<double> macd, std::span<double> signal,
+                           std::span<double> histogram) {
+    const std::size_t n = prices.size();
+    requireLength("macd", std::min({macd.size(), signal.size(), histogram.size()}), n);
+    const std::size_t warm = std::min(n, MACDState::kSlow);
+
+    MACDState state;
+    for (std::size_t i = 0; i < warm; ++i) {
+        bool ready = state.update(prices[i]);
+        macd[i] = state.macd();
+        signal[i] = state.signal;
+        histogram[i] = ready ? state.macd() - state.signal : 0.0;
+    }
+
+    // Fast EMA in 'macd', slow EMA in 'histogram', then the line and its signal
+    const Kernels& kernel = kernels();
+    const double alpha_fast = 2.0 / (MACDState::kFast + 1.0);
+    const double alpha_slow = 2.0 / (MACDState::kSlow + 1.0);
+    const double alpha_signal = 2.0 / (MACDState::kSignal + 1.0);
+    double ema_fast = state.ema_fast, ema_slow = state.ema_slow, signal_carry = state.signal;
+    for (std::size_t begin = warm; begin < n; begin += kChunk) {
+        const std::size_t end = std::min(n, begin + kChunk);
+        const std::size_t count = end - begin;
+        for (std::size_t i = begin; i < end; ++i) {
+            macd[i] = alpha_fast * prices[i];
+            histogram[i] = alpha_slow * prices[i];
+        }
+        ema_fast = kernel.scan(macd.data() + begin, count, 1.0 - alpha_fast, ema_fast);
+        ema_slow = kernel.scan(histogram.data() + begin, count, 1.0 - alpha_slow, ema_slow);
+        for (std::size_t i = begin; i < end; ++i) {
+            macd[i] -= histogram[i];
+            signal[i] = alpha_signal * macd[i];
+        }
+        signal_carry = kernel.scan(signal.data() + begin, count, 1.0 - alpha_signal, signal_carry);
+        for (std::size_t i = begin; i < end; ++i) histogram[i] = macd[i] - signal[i];
+    }
+}
+
+} // namespace AlgoCatalyst
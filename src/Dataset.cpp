@@ -0,0 +1,320 @@
+#include "Dataset.h"
+#include "Engine.h"
+#include "MappedFile.h"
+#include "TickBlocks.h"
+#include "TickFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <tuple>
+
+namespace AlgoCatalyst {
+
+namespace {
+
+constexpr const char* kManifestHeader = "symbol,path,rows,first_timestamp_us,last_timestamp_us,bytes,checksum";
+
+// A partition file holds one symbol; binary files may name it differently
+template <typename File>
+const typename File::SymbolRange* partitionRange(const File& file, std::string_view symbol) {
+    const typename File::SymbolRange* range = file.findSymbol(symbol);
+    if (!range && file.symbols().size() == 1) range = &file.symbols().front();
+    return range;
+}
+
+bool isTickFileName(const std::filesystem::path& path) {
+    const std::string ext = path.extension().string();
+    return ext == ".csv" || ext == ".actk" || ext == ".actz";
+}
+
+// Rows and time range of one partition file; false if it cannot be read
+bool summarise(const std::string& path, const std::string& symbol, DatasetPartition& out) {
+    if (CompressedTickFile::isCompressedFile(path)) {
+        CompressedTickFilePtr file = CompressedTickFile::open(path);
+        const auto* range = file ? partitionRange(*file, symbol) : nullptr;
+        if (!range) return false;
+        out.rows = range->row_count;
+        if (range->block_count > 0) {
+            out.first_timestamp_us = file->blocks()[range->first_block].min_timestamp_us;
+            out.last_timestamp_us = file->blocks()[range->first_block + range->block_count - 1].max_timestamp_us;
+        }
+        return true;
+    }
+    if (ColumnarTickFile::isTickFile(path)) {
+        TickFilePtr file = ColumnarTickFile::open(path);
+        const auto* range = file ? partitionRange(*file, symbol) : nullptr;
+        if (!range) return false;
+        out.rows = range->row_count;
+        if (range->row_count > 0) {
+            auto ts = file->timestamps().subspan(range->first_row, range->row_count);
+            out.first_timestamp_us = ts.front();
+            out.last_timestamp_us = ts.back();
+        }
+        return true;
+    }
+
+    TickLoadOptions options;
+    options.verbose = false;
+    std::vector<Tick> ticks = TickLoader::loadFromCSV(path, options);
+    out.rows = ticks.size();
+    if (!ticks.empty()) {
+        auto [lo, hi] = std::minmax_element(ticks.begin(), ticks.end(), [](const Tick& a, const Tick& b) {
+            return a.timestamp_us < b.timestamp_us;
+        });
+        out.first_timestamp_us = lo->timestamp_us;
+        out.last_timestamp_us = hi->timestamp_us;
+    }
+    return true;
+}
+
+template <typename T>
+bool parseField(std::string_view field, T& out, int base = 10) {
+    auto [ptr, ec] = std::from_chars(field.data(), field.data() + field.size(), out, base);
+    return ec == std::errc() && ptr == field.data() + field.size();
+}
+
+bool parseManifestLine(std::string_view line, DatasetPartition& out) {
+    std::string_view fields[7];
+    std::size_t n = 0;
+    while (n < 7) {
+        std::size_t comma = line.find(',');
+        fields[n++] = line.substr(0, comma);
+        if (comma == std::string_view::npos) break;
+        line.remove_prefix(comma + 1);
+    }
+    if (n != 7 || fields[0].empty() || fields[1].empty()) return false;
+    out.symbol = fields[0];
+    out.path = fields[1];
+    return parseField(fields[2], out.rows) && parseField(fields[3], out.first_timestamp_us) &&
+           parseField(fields[4], out.last_timestamp_us) && parseField(fields[5], out.bytes) &&
+           parseField(fields[6], out.checksum, 16);
+}
+
+bool byTime(const DatasetPartition& a, const DatasetPartition& b) {
+    return std::tie(a.symbol, a.first_timestamp_us, a.path) < std::tie(b.symbol, b.first_timestamp_us, b.path);
+}
+
+} // namespace
+
+// Dataset Implementation
+bool Dataset::checksumFile(const std::string& path, std::uint64_t& checksum, std::uint64_t& bytes) {
+    MappedFile file(path);
+    if (!file.is_open()) return false;
+    std::uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : file.view()) {
+        h = (h ^ c) * 1099511628211ULL;
+    }
+    checksum = h;
+    bytes = file.size();
+    return true;
+}
+
+std::shared_ptr<const Dataset> Dataset::open(const std::string& root) {
+    const std::string manifest = root + "/" + kManifestName;
+    std::ifstream in(manifest);
+    if (!in) {
+        std::cerr << "Error: Cannot open dataset manifest " << manifest << " (run 'dataset index " << root
+                  << "' to create it)" << std::endl;
+        return nullptr;
+    }
+
+    std::shared_ptr<Dataset> dataset(new Dataset());
+    dataset->root_ = root;
+    std::string line;
+    std::size_t line_num = 0;
+    while (std::getline(in, line)) {
+        ++line_num;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line_num == 1 || line.empty() || line[0] == '#') continue;
+        DatasetPartition partition;
+        if (!parseManifestLine(line, partition)) {
+            std::cerr << "Error: " << manifest << ": line " << line_num << ": malformed entry" << std::endl;
+            return nullptr;
+        }
+        dataset->partitions_.push_back(std::move(partition));
+    }
+    std::sort(dataset->partitions_.begin(), dataset->partitions_.end(), byTime);
+
+    // Partitions are concatenated per symbol, so overlapping ones would feed ticks out of order
+    const auto& parts = dataset->partitions_;
+    for (std::size_t i = 1; i < parts.size(); ++i) {
+        if (parts[i].symbol == parts[i - 1].symbol && parts[i].rows > 0 && parts[i - 1].rows > 0 &&
+            parts[i].first_timestamp_us < parts[i - 1].last_timestamp_us) {
+            std::cerr << "[WARN] " << parts[i].path << " overlaps " << parts[i - 1].path
+                      << " in time; its ticks will be out of order\n";
+        }
+    }
+    return dataset;
+}
+
+bool Dataset::buildIndex(const std::string& root) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    if (!fs::is_directory(root, ec)) {
+        std::cerr << "Error: " << root << " is not a directory" << std::endl;
+        return false;
+    }
+
+    std::vector<DatasetPartition> partitions;
+    for (const auto& dir : fs::directory_iterator(root, ec)) {
+        if (!dir.is_directory()) continue;
+        const std::string symbol = dir.path().filename().string();
+        for (const auto& entry : fs::directory_iterator(dir.path(), ec)) {
+            if (!entry.is_regular_file() || !isTickFileName(entry.path())) continue;
+            DatasetPartition partition;
+            partition.symbol = symbol;
+            partition.path = symbol + "/" + entry.path().filename().string();
+            const std::string path = entry.path().string();
+            if (!checksumFile(path, partition.checksum, partition.bytes) || !summarise(path, symbol, partition)) {
+                std::cerr << "Error: Cannot read partition " << path << std::endl;
+                return false;
+            }
+            partitions.push_back(std::move(partition));
+        }
+    }
+    if (ec) {
+        std::cerr << "Error: Cannot scan " << root << ": " << ec.message() << std::endl;
+        return false;
+    }
+    std::sort(partitions.begin(), partitions.end(), byTime);
+
+    // Written aside and renamed, so a failed index never leaves a truncated manifest
+    const std::string manifest = root + "/" + kManifestName;
+    const std::string tmp = manifest + ".tmp";
+    {
+        std::ofstream out(tmp);
+        out << kManifestHeader << "\n";
+        char hex[17];
+        for (const auto& p : partitions) {
+            std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(p.checksum));
+            out << p.symbol << ',' << p.path << ',' << p.rows << ',' << p.first_timestamp_us << ','
+                << p.last_timestamp_us << ',' << p.bytes << ',' << hex << "\n";
+        }
+        if (!out) {
+            std::cerr << "Error: Cannot write " << tmp << std::endl;
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), manifest.c_str()) != 0) {
+        std::cerr << "Error: Cannot write " << manifest << std::endl;
+        return false;
+    }
+
+    std::uint64_t rows = 0;
+    for (const auto& p : partitions) rows += p.rows;
+    Dataset indexed;
+    indexed.partitions_ = std::move(partitions);
+    std::cout << "Indexed " << indexed.partitions_.size() << " partitions (" << indexed.symbols().size()
+              << " symbols, " << rows << " ticks) into " << manifest << std::endl;
+    return true;
+}
+
+std::vector<std::string> Dataset::symbols() const {
+    std::vector<std::string> names;
+    for (const auto& p : partitions_) {
+        if (names.empty() || names.back() != p.symbol) names.push_back(p.symbol);
+    }
+    return names;
+}
+
+std::vector<const DatasetPartition*> Dataset::select(std::string_view symbol, const TickFilter& filter) const {
+    std::vector<const DatasetPartition*> selected;
+    auto it = std::lower_bound(partitions_.begin(), partitions_.end(), symbol,
+                               [](const DatasetPartition& p, std::string_view s) { return p.symbol < s; });
+    for (; it != partitions_.end() && it->symbol == symbol; ++it) {
+        if (it->rows == 0) continue;
+        // Some passing timestamp must fall inside [first, last]
+        std::int64_t next = filter.nextInside(it->first_timestamp_us);
+        if (next < filter.end_us && next <= it->last_timestamp_us) selected.push_back(&*it);
+    }
+    return selected;
+}
+
+std::size_t Dataset::verify() const {
+    std::size_t changed = 0;
+    for (const auto& p : partitions_) {
+        std::uint64_t checksum = 0, bytes = 0;
+        if (!checksumFile(pathOf(p), checksum, bytes)) {
+            std::cerr << "[WARN] " << p.path << ": missing\n";
+            ++changed;
+        } else if (bytes != p.bytes || checksum != p.checksum) {
+            std::cerr << "[WARN] " << p.path << ": changed since it was indexed\n";
+            ++changed;
+        }
+    }
+    return changed;
+}
+
+// PartitionedTickSource Implementation
+PartitionedTickSource::PartitionedTickSource(DatasetPtr dataset, std::vector<const DatasetPartition*> partitions,
+                                             SymbolId symbol, const TickFilter& filter)
+    : dataset_(std::move(dataset)), partitions_(std::move(partitions)), symbol_(symbol), filter_(filter) {
+}
+
+PartitionedTickSource::~PartitionedTickSource() = default;
+
+bool PartitionedTickSource::rewind() {
+    next_ = 0;
+    current_.reset();
+    ticks_.clear();
+    head_ = nullptr;
+    has_run_ = false;
+    return true;
+}
+
+bool PartitionedTickSource::isSorted() const {
+    const DatasetPartition* previous = nullptr;
+    for (const DatasetPartition* part : partitions_) {
+        const std::string ext = std::filesystem::path(part->path).extension().string();
+        if (ext != ".actk" && ext != ".actz") return false;
+        if (previous && part->first_timestamp_us < previous->last_timestamp_us) return false;
+        previous = part;
+    }
+    return true;
+}
+
+bool PartitionedTickSource::openNext() {
+    while (next_ < partitions_.size()) {
+        const DatasetPartition& part = *partitions_[next_++];
+        const std::string path = dataset_->pathOf(part);
+        current_.reset();
+        ticks_.clear();
+
+        if (CompressedTickFile::isCompressedFile(path)) {
+            CompressedTickFilePtr file = CompressedTickFile::open(path);
+            if (const auto* range = file ? partitionRange(*file, part.symbol) : nullptr) {
+                current_ = std::make_unique<CompressedTickSource>(file, *range, symbol_, filter_);
+                return true;
+            }
+        } else if (ColumnarTickFile::isTickFile(path)) {
+            TickFilePtr file = ColumnarTickFile::open(path);
+            if (const auto* range = file ? partitionRange(*file, part.symbol) : nullptr) {
+                std::vector<RowRange> rows;
+                if (filter_.passesAll()) rows.push_back({range->first_row, range->first_row + range->row_count});
+                else rows = file->selectRows(*range, filter_);
+                current_ = std::make_unique<ColumnarTickSource>(std::move(file), std::move(rows), symbol_);
+                return true;
+            }
+        } else {
+            // Day-sized files: one parser thread and no TickStore entry per file. The
+            // side-car cache follows the store's mode, so with the CLI default each
+            // CSV partition gets a <file>.tickcache next to it (index ignores them)
+            TickLoadOptions options;
+            options.threads = 1;
+            options.filter = filter_;
+            options.verbose = false;
+            options.cache = TickStore::global().cacheMode();
+            ticks_ = TickLoader::loadFromCSV(path, options);
+            for (Tick& tick : ticks_) tick.symbol_id = symbol_;
+            current_ = std::make_unique<VectorTickSource>(ticks_);
+            return true;
+        }
+        std::cerr << "Error: " << path << ": no ticks for " << part.symbol << "; skipping partition" << std::endl;
+    }
+    return false;
+}
+
+} // namespace AlgoCatalyst
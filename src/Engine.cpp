@@ -3,232 +3,529 @@
 #include "AI_Regime.h"
 #include "Version.h"
 #include <fstream>
-#include <sstream>
 #include <iostream>
 #include <iomanip>
 #include <chrono>
 #include <algorithm>
-#include <ctime>
+#include <cmath>
+#include <numeric>
+#include <exception>
+#include <thread>
 
 namespace AlgoCatalyst {
 
+TickInput TickInput::open(const std::string& path, const std::string& symbol, const TickFilter& filter) {
+    TickInput input;
+    if (CompressedTickFile::isCompressedFile(path)) input.compressed = CompressedTickFile::open(path);
+    else if (ColumnarTickFile::isTickFile(path)) input.file = ColumnarTickFile::open(path);
+    else input.ticks = TickStore::global().load(path, symbol, filter);
+    return input;
+}
+
 // Backtester Implementation
 Backtester::Backtester(double latency_ms)
     : latency_ms_(latency_ms), current_time_us_(0) {
 }
 
-bool Backtester::loadTickData(const std::string& csv_path, const std::string& symbol) {
-    std::vector<Tick> ticks = TickLoader::loadFromCSV(csv_path);
+Backtester::~Backtester() = default;
+
+bool Backtester::loadTickData(const std::string& csv_path, const std::string& symbol, const TickFilter& filter) {
+    TickInput input = TickInput::open(csv_path, symbol, filter);
+    if (!addTickInput(symbol, input, filter)) return false;
+    if (verbose_ && input.compressed) {
+        std::cout << "Mapped " << input.compressed->rows() << " compressed ticks (" << input.compressed->blocks().size()
+                  << " blocks, " << input.compressed->bytes() << " bytes) from " << csv_path << std::endl;
+    } else if (verbose_ && input.file) {
+        std::cout << "Mapped " << input.file->rows() << " ticks (" << input.file->symbols().size()
+                  << " symbol(s)) from " << csv_path << std::endl;
+    }
+    return true;
+}
+
+bool Backtester::addTickInput(const std::string& symbol, const TickInput& input, const TickFilter& filter) {
+    if (input.compressed) return addCompressedTickFile(symbol, input.compressed, filter);
+    if (input.file) return addTickFile(symbol, input.file, filter);
+    if (!input.ticks) return false;
+    addTickSeries(symbol, input.ticks);
+    return true;
+}
+
+bool Backtester::streamTickData(const std::string& csv_path, const std::string& symbol, const TickFilter& filter) {
+    if (CompressedTickFile::isCompressedFile(csv_path) || ColumnarTickFile::isTickFile(csv_path)) {
+        return loadTickData(csv_path, symbol, filter);
+    }
+
+    SymbolId id = addSymbol(symbol);
+    auto reader = std::make_unique<StreamingTickReader>(csv_path, id, filter);
+    if (!reader->is_open()) return false;
+    tick_data_[id] = nullptr;
+    tick_files_[id] = nullptr;
+    fill_pricers_[id] = FillPricer();
+    addTickSource(symbol, std::move(reader));
+    if (verbose_) std::cout << "Streaming ticks from " << csv_path << std::endl;
+    return true;
+}
+
+void Backtester::addTickSeries(const std::string& symbol, TickSeriesPtr ticks) {
+    SymbolId id = addSymbol(symbol);
+    tick_data_[id] = std::move(ticks);
+    tick_files_[id] = nullptr;
+    fill_pricers_[id] = FillPricer(*tick_data_[id]);
     
-    if (ticks.empty()) {
+    // Ticks stay in the shared series; run() streams them through a cursor
+    addTickSource(symbol, std::make_unique<VectorTickSource>(*tick_data_[id]));
+}
+
+bool Backtester::addTickFile(const std::string& symbol, TickFilePtr file, const TickFilter& filter) {
+    const ColumnarTickFile::SymbolRange* range = file->findSymbol(symbol);
+    if (!range && file->symbols().size() == 1) range = &file->symbols().front();
+    if (!range) {
+        std::cerr << "Error: Symbol " << symbol << " not found in tick file" << std::endl;
         return false;
     }
-    
-    tick_data_[symbol] = std::move(ticks);
-    
-    // Load all ticks into event queue as MarketUpdateEvents
-    for (const auto& tick : tick_data_[symbol]) {
-        event_queue_.push(std::make_unique<MarketUpdateEvent>(tick.timestamp_us, tick));
+
+    SymbolId id = addSymbol(symbol);
+    std::vector<RowRange> rows;
+    if (filter.passesAll()) rows.push_back({range->first_row, range->first_row + range->row_count});
+    else rows = file->selectRows(*range, filter);
+
+    // Fills price within the selected window, skipping rows between sessions
+    std::size_t first = rows.empty() ? 0 : static_cast<std::size_t>(rows.front().begin);
+    std::size_t count = rows.empty() ? 0 : static_cast<std::size_t>(rows.back().end) - first;
+    fill_pricers_[id] = FillPricer(file->timestamps().subspan(first, count), file->prices().subspan(first, count));
+    if (filter.hasSession()) fill_pricers_[id].restrictTo(filter);
+    addTickSource(symbol, std::make_unique<ColumnarTickSource>(file, std::move(rows), id));
+    tick_files_[id] = std::move(file);
+    return true;
+}
+
+bool Backtester::addCompressedTickFile(const std::string& symbol, CompressedTickFilePtr file,
+                                       const TickFilter& filter) {
+    const CompressedTickFile::SymbolRange* range = file->findSymbol(symbol);
+    if (!range && file->symbols().size() == 1) range = &file->symbols().front();
+    if (!range) {
+        std::cerr << "Error: Symbol " << symbol << " not found in tick file" << std::endl;
+        return false;
     }
-    
+
+    // Blocks are decoded once, as the stream reaches them; fills price off the source
+    SymbolId id = addSymbol(symbol);
+    tick_data_[id] = nullptr;
+    tick_files_[id] = nullptr;
+    fill_pricers_[id] = FillPricer();
+    addTickSource(symbol, std::make_unique<CompressedTickSource>(std::move(file), *range, id, filter));
     return true;
 }
 
+bool Backtester::addDataset(const std::string& symbol, DatasetPtr dataset, const TickFilter& filter) {
+    std::vector<const DatasetPartition*> partitions = dataset->select(symbol, filter);
+    if (partitions.empty()) {
+        std::cerr << "Error: No partitions for " << symbol << " in dataset " << dataset->root() << std::endl;
+        return false;
+    }
+
+    SymbolId id = addSymbol(symbol);
+    tick_data_[id] = nullptr;
+    tick_files_[id] = nullptr;
+    fill_pricers_[id] = FillPricer();
+    addTickSource(symbol, std::make_unique<PartitionedTickSource>(std::move(dataset), std::move(partitions), id, filter));
+    return true;
+}
+
+void Backtester::addTickSource(const std::string& symbol, std::unique_ptr<TickSource> source) {
+    SymbolId id = addSymbol(symbol);
+    streamed_sources_[id] = dynamic_cast<StreamedTickSource*>(source.get());
+    for (auto& stream : streams_) {
+        if (stream.symbol == id) {
+            stream.source = std::move(source);
+            return;
+        }
+    }
+    streams_.push_back({id, std::move(source)});
+}
+
 void Backtester::registerStrategy(const std::string& symbol, std::unique_ptr<Strategy> strategy) {
-    strategies_[symbol] = std::move(strategy);
+    strategies_[addSymbol(symbol)] = std::move(strategy);
+}
+
+SymbolId Backtester::addSymbol(const std::string& symbol) {
+    SymbolId id = internSymbol(symbol);
+    growSymbolTables(id);
+    return id;
+}
+
+void Backtester::growSymbolTables(SymbolId id) {
+    if (id < positions_.size()) return;
+    std::size_t n = static_cast<std::size_t>(id) + 1;
+    strategies_.resize(n);
+    tick_data_.resize(n);
+    tick_files_.resize(n);
+    fill_pricers_.resize(n);
+    streamed_sources_.resize(n);
+    positions_.resize(n);
+    last_quotes_.resize(n);
 }
 
 void Backtester::run() {
-    std::cout << "Starting backtest...\n"
-              << "Latency:    " << latency_ms_ << " ms\n"
-              << "Slippage:   " << slippage_bps_ << " bps\n"
-              << "Commission: $" << commission_per_share_ << "/share (min $" << min_commission_ << ")\n"
-              << "Processing " << event_queue_.size() << " events...\n";
+    // Symbols are independent unless portfolio breakers couple them through equity
+    unsigned num_shards = hasPortfolioRiskLimits() ? 1u
+        : static_cast<unsigned>(std::min<std::size_t>(threads_, streams_.size()));
+    if (num_shards == 0) num_shards = 1;
+    selectScheduler();
+
+    if (verbose_) {
+        std::cout << "Starting backtest...\n"
+                  << "Latency:    " << latency_ms_ << " ms\n"
+                  << "Slippage:   " << slippage_bps_ << " bps\n"
+                  << "Commission: $" << commission_per_share_ << "/share (min $" << min_commission_ << ")\n";
+        if (threads_ > 1 && hasPortfolioRiskLimits()) {
+            std::cout << "Portfolio risk limits set: running single-threaded\n";
+        }
+        std::cout << "Merging " << streams_.size() << " tick stream(s)"
+                  << (num_shards > 1 ? " on " + std::to_string(num_shards) + " threads" : "")
+                  << "...\n";
+    }
     
     auto start_time = std::chrono::high_resolution_clock::now();
     std::size_t events_processed = 0;
-    
-    while (!event_queue_.empty()) {
-        EventPtr event = std::move(const_cast<EventPtr&>(event_queue_.top()));
-        event_queue_.pop();
-        
-        current_time_us_ = event->getTimestamp();
-        processEvent(std::move(event));
-        
-        events_processed++;
-        
-        // Progress indicator every 100k events
-        if (events_processed % 100000 == 0) {
-            std::cout << "Processed " << events_processed << " events..." << std::endl;
-        }
+
+    if (num_shards > 1) {
+        events_processed = runSharded(num_shards);
+    } else {
+        events_processed = processStreams();
+        closeOpenPositions();
     }
+    canonicalizeTradeLog();
     
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
     
+    if (!verbose_) return;
+
     std::cout << "\nBacktest completed!" << std::endl;
     std::cout << "Events processed: " << events_processed << std::endl;
     std::cout << "Processing time: " << duration.count() << " ms" << std::endl;
-    
-    // Close any remaining positions
-    for (auto& [symbol, position] : positions_) {
-        if (position.quantity != 0.0 && !tick_data_[symbol].empty()) {
-            const Tick& last_tick = tick_data_[symbol].back();
-            closePosition(symbol, last_tick.price, last_tick.timestamp_us);
-        }
+    if (num_shards == 1) {
+        EventStore::Stats stats = events_.stats();
+        std::cout << "Event store: " << schedulerName(events_.schedulerKind());
+        if (stats.fallbacks) std::cout << " (fell back from radix-heap: ticks out of time order)";
+        else if (scheduler_ == SchedulerKind::Auto) std::cout << " (auto)";
+        std::cout << ", peak " << stats.peak_live << " queued, " << stats.allocations << " allocations" << std::endl;
     }
     
     printTradeLog();
 }
 
-void Backtester::processEvent(EventPtr event) {
-    switch (event->getType()) {
-        case EventType::MarketUpdate: {
-            auto market_event = std::unique_ptr<MarketUpdateEvent>(
-                static_cast<MarketUpdateEvent*>(event.release()));
-            processMarketUpdate(std::move(market_event));
-            break;
-        }
-        case EventType::SignalEvent: {
-            auto signal_event = std::unique_ptr<SignalEvent>(
-                static_cast<SignalEvent*>(event.release()));
-            processSignalEvent(std::move(signal_event));
-            break;
-        }
-        case EventType::OrderEvent: {
-            auto order_event = std::unique_ptr<OrderEvent>(
-                static_cast<OrderEvent*>(event.release()));
-            processOrderEvent(std::move(order_event));
-            break;
-        }
-        case EventType::FillEvent: {
-            auto fill_event = std::unique_ptr<FillEvent>(
-                static_cast<FillEvent*>(event.release()));
-            processFillEvent(std::move(fill_event));
-            break;
-        }
+void Backtester::selectScheduler() {
+    SchedulerKind kind = scheduler_;
+    if (kind == SchedulerKind::Auto) {
+        bool sorted = std::all_of(streams_.begin(), streams_.end(),
+                                  [](const TickStream& stream) { return stream.source->isSorted(); });
+        kind = sorted ? SchedulerKind::RadixHeap : SchedulerKind::BinaryHeap;
     }
+    if (events_.schedulerKind() != kind) events_ = EventStore(kind);
 }
 
-void Backtester::processMarketUpdate(std::unique_ptr<MarketUpdateEvent> event) {
-    // Find symbol from tick data by matching timestamp range
-    std::string event_symbol;
+bool Backtester::reset() {
+    events_.clear();
+    trade_log_.clear();
+    liquidation_begin_ = 0;
+    risk_ = RiskState{};
+    current_time_us_ = 0;
+    std::fill(positions_.begin(), positions_.end(), Position{});
+    std::fill(last_quotes_.begin(), last_quotes_.end(), LastQuote{});
+    for (auto& pricer : fill_pricers_) {
+        pricer.reset();
+    }
+    for (auto& strategy : strategies_) {
+        if (strategy) strategy->reset();
+    }
+
+    bool rewound = true;
+    for (auto& stream : streams_) {
+        rewound = stream.source->rewind() && rewound;
+    }
+    return rewound;
+}
+
+std::size_t Backtester::processStreams() {
+    std::size_t events_processed = 0;
+
+    std::fill(last_quotes_.begin(), last_quotes_.end(), LastQuote{});
+    for (auto& pricer : fill_pricers_) {
+        pricer.reset();
+    }
+
+    // Min-heap of stream heads; ties resolve by symbol slot for a deterministic merge
+    auto later = [](const StreamHead& a, const StreamHead& b) {
+        if (a.timestamp_us != b.timestamp_us) return a.timestamp_us > b.timestamp_us;
+        return a.stream > b.stream;
+    };
+    std::vector<StreamHead> heads;
+    heads.reserve(streams_.size());
+    for (std::uint32_t i = 0; i < streams_.size(); ++i) {
+        if (const Tick* tick = streams_[i].source->peek()) {
+            heads.push_back({tick->timestamp_us, i});
+        }
+    }
+    std::make_heap(heads.begin(), heads.end(), later);
     
-    for (const auto& [sym, ticks] : tick_data_) {
-        if (ticks.empty()) continue;
-        
-        // Check if this tick belongs to this symbol's data
-        // Match by timestamp (within reasonable range of first tick)
-        const Tick& event_tick = event->getTick();
-        const Tick& first_tick = ticks[0];
+    while (!heads.empty() || !events_.empty()) {
+        // Scheduled events win ties so a fill at time T prices off the first tick at or after T
+        bool take_tick = !heads.empty() &&
+            (events_.empty() || heads.front().timestamp_us < events_.top().timestamp_us);
+
+        if (take_tick) {
+            std::pop_heap(heads.begin(), heads.end(), later);
+            TickStream& stream = streams_[heads.back().stream];
+            const Tick& tick = *stream.source->peek();
+
+            current_time_us_ = tick.timestamp_us;
+            processMarketUpdate(stream.symbol, tick);
+            stream.source->advance();
+
+            if (const Tick* next = stream.source->peek()) {
+                heads.back().timestamp_us = next->timestamp_us;
+                std::push_heap(heads.begin(), heads.end(), later);
+            } else {
+                heads.pop_back();
+            }
+        } else {
+            EventRecord event = events_.pop();
+            current_time_us_ = event.timestamp_us;
+            processEvent(event);
+        }
         
-        // Simple heuristic: if timestamp matches or is within range, assume same symbol
-        // In practice, we'd track symbol with each tick or use a better method
-        bool likely_match = (event_tick.timestamp_us >= first_tick.timestamp_us) &&
-                           (event_tick.timestamp_us <= (first_tick.timestamp_us + 1000000000LL)); // 1000 seconds
+        events_processed++;
         
-        if (likely_match) {
-            event_symbol = sym;
-            break;
+        // Progress indicator every 100k events
+        if (verbose_ && events_processed % 100000 == 0) {
+            std::cout << "Processed " << events_processed << " events... equity $"
+                      << risk_.realized_equity << std::endl;
         }
     }
-    
-    // Default to first symbol if only one exists (common case)
-    if (event_symbol.empty() && !tick_data_.empty()) {
-        if (tick_data_.size() == 1) {
-            event_symbol = tick_data_.begin()->first;
-        } else if (!strategies_.empty()) {
-            // Use first strategy's symbol
-            event_symbol = strategies_.begin()->first;
+
+    return events_processed;
+}
+
+void Backtester::closeOpenPositions() {
+    // Close any remaining positions at the last tick seen for the symbol
+    liquidation_begin_ = trade_log_.size();
+    for (SymbolId id = 0; id < positions_.size(); ++id) {
+        if (positions_[id].quantity != 0.0 && last_quotes_[id].valid) {
+            closePosition(id, last_quotes_[id].price, last_quotes_[id].timestamp_us);
         }
     }
-    
+}
+
+std::size_t Backtester::runSharded(unsigned num_shards) {
+    // Deal streams round-robin to shard engines that share this engine's
+    // execution settings; tick storage stays here and outlives the shards
+    std::vector<std::unique_ptr<Backtester>> shards;
+    for (unsigned i = 0; i < num_shards; ++i) {
+        auto shard = std::make_unique<Backtester>(latency_ms_);
+        shard->slippage_bps_ = slippage_bps_;
+        shard->commission_per_share_ = commission_per_share_;
+        shard->min_commission_ = min_commission_;
+        shard->max_positions_per_symbol_ = max_positions_per_symbol_;
+        shard->commission_free_ = commission_free_;
+        shard->events_ = EventStore(events_.schedulerKind());
+        shard->verbose_ = false;
+        shards.push_back(std::move(shard));
+    }
+    for (std::size_t i = 0; i < streams_.size(); ++i) {
+        Backtester& shard = *shards[i % num_shards];
+        SymbolId id = streams_[i].symbol;
+        shard.growSymbolTables(id);
+        shard.strategies_[id] = std::move(strategies_[id]);
+        shard.fill_pricers_[id] = fill_pricers_[id];
+        shard.streamed_sources_[id] = streamed_sources_[id];
+        shard.streams_.push_back(std::move(streams_[i]));
+    }
+
+    std::vector<std::size_t> shard_events(num_shards, 0);
+    std::vector<std::exception_ptr> errors(num_shards);
+    std::vector<std::thread> workers;
+    workers.reserve(num_shards);
+    for (unsigned i = 0; i < num_shards; ++i) {
+        workers.emplace_back([&, i] {
+            try {
+                shard_events[i] = shards[i]->processStreams();
+                shards[i]->closeOpenPositions();
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Hand symbols back so the engine owns its strategies and sources again
+    for (auto& shard : shards) {
+        for (auto& stream : shard->streams_) {
+            strategies_[stream.symbol] = std::move(shard->strategies_[stream.symbol]);
+        }
+    }
+    for (std::size_t i = 0; i < streams_.size(); ++i) {
+        streams_[i] = std::move(shards[i % num_shards]->streams_[i / num_shards]);
+    }
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Regular exits first, then end-of-run liquidations; canonicalizeTradeLog() orders each part
+    std::vector<TradeRecord> liquidations;
+    for (auto& shard : shards) {
+        auto& log = shard->trade_log_;
+        auto split = log.begin() + static_cast<std::ptrdiff_t>(shard->liquidation_begin_);
+        trade_log_.insert(trade_log_.end(), std::make_move_iterator(log.begin()),
+                          std::make_move_iterator(split));
+        liquidations.insert(liquidations.end(), std::make_move_iterator(split),
+                            std::make_move_iterator(log.end()));
+    }
+    liquidation_begin_ = trade_log_.size();
+    trade_log_.insert(trade_log_.end(), std::make_move_iterator(liquidations.begin()),
+                      std::make_move_iterator(liquidations.end()));
+
+    return std::accumulate(shard_events.begin(), shard_events.end(), std::size_t{0});
+}
+
+void Backtester::canonicalizeTradeLog() {
+    // With portfolio breakers the log must stay in the order the breakers saw it
+    if (hasPortfolioRiskLimits()) return;
+
+    // Exits are already time-ordered per symbol; a stable sort only fixes the order
+    // of different symbols' exits at the same timestamp (and interleaves shards)
+    auto split = trade_log_.begin() + static_cast<std::ptrdiff_t>(liquidation_begin_);
+    std::stable_sort(trade_log_.begin(), split, [](const TradeRecord& a, const TradeRecord& b) {
+        if (a.exit_timestamp_us != b.exit_timestamp_us) return a.exit_timestamp_us < b.exit_timestamp_us;
+        return a.symbol_id < b.symbol_id;
+    });
+    std::stable_sort(split, trade_log_.end(), [](const TradeRecord& a, const TradeRecord& b) {
+        return a.symbol_id < b.symbol_id;
+    });
+
+    // Re-fold equity in log order so totals are bit-identical across thread counts
+    risk_ = RiskState{};
+    for (const auto& trade : trade_log_) {
+        updateRiskState(trade.pnl, trade.exit_timestamp_us);
+    }
+}
+
+void Backtester::processEvent(const EventRecord& event) {
+    switch (event.type) {
+        case EventType::MarketUpdate:
+            processMarketUpdate(event.symbol, *event.tick);
+            break;
+        case EventType::SignalEvent:
+            processSignalEvent(event);
+            break;
+        case EventType::OrderEvent:
+            processOrderEvent(event);
+            break;
+        case EventType::FillEvent:
+            processFillEvent(event);
+            break;
+    }
+}
+
+void Backtester::processMarketUpdate(SymbolId symbol, const Tick& tick) {
+    LastQuote& last = last_quotes_[symbol];
+    last.price = tick.price;
+    last.timestamp_us = tick.timestamp_us;
+    last.valid = true;
+
+    rollRiskDay(tick.timestamp_us);
+
     // Process with strategy (skip if risk circuit breaker is active)
-    if (!event_symbol.empty() && strategies_.find(event_symbol) != strategies_.end() && !risk_halt_) {
-        auto signals = strategies_[event_symbol]->processMarketUpdate(*event);
+    Strategy* strategy = strategies_[symbol].get();
+    if (strategy && !risk_.halted()) {
+        signal_out_.clear();
+        strategy->onMarketUpdate(tick, signal_out_);
 
         // Update MAE/MFE for open positions on every tick
-        if (positions_.find(event_symbol) != positions_.end()) {
-            Position& pos = positions_[event_symbol];
-            if (pos.quantity != 0.0 && pos.avg_price > 0.0) {
-                const Tick& t = event->getTick();
-                double unrealized = (t.price - pos.avg_price) * pos.quantity;
-                pos.mfe = std::max(pos.mfe, unrealized);
-                pos.mae = std::min(pos.mae, unrealized);
-            }
+        Position& pos = positions_[symbol];
+        if (pos.quantity != 0.0 && pos.avg_price > 0.0) {
+            double unrealized = (tick.price - pos.avg_price) * pos.quantity;
+            pos.mfe = std::max(pos.mfe, unrealized);
+            pos.mae = std::min(pos.mae, unrealized);
         }
 
         // Add signal events to queue
-        for (auto& signal : signals) {
-            event_queue_.push(std::move(signal));
+        for (const Signal& sig : signal_out_) {
+            EventRecord record{};
+            record.type = EventType::SignalEvent;
+            record.direction = sig.direction;
+            record.symbol = sig.symbol;
+            record.timestamp_us = sig.timestamp_us;
+            record.order = {sig.quantity, sig.price, 0.0};
+            growSymbolTables(record.symbol);
+            events_.push(record);
         }
     }
 }
 
-void Backtester::processSignalEvent(std::unique_ptr<SignalEvent> event) {
-    const std::string& symbol = event->getSymbol();
-    
+void Backtester::processSignalEvent(const EventRecord& event) {
     // Create order event
-    auto order_event = std::make_unique<OrderEvent>(
-        event->getTimestamp(),
-        symbol,
-        event->getDirection(),
-        event->getQuantity(),
-        event->getPrice()
-    );
+    EventRecord order_event = event;
+    order_event.type = EventType::OrderEvent;
     
     // Add order to queue
-    event_queue_.push(std::move(order_event));
+    events_.push(order_event);
 }
 
-void Backtester::processOrderEvent(std::unique_ptr<OrderEvent> event) {
-    const std::string& symbol = event->getSymbol();
-    
+void Backtester::processOrderEvent(const EventRecord& event) {
     // Simulate latency: Fill happens after latency_ms_ milliseconds
-    std::int64_t fill_timestamp_us = applyLatency(event->getTimestamp());
-    
-    // Get market price at fill time
-    double fill_price = event->getPrice();
-    
-    if (tick_data_.find(symbol) != tick_data_.end()) {
-        const auto& ticks = tick_data_[symbol];
-        for (const auto& tick : ticks) {
-            if (tick.timestamp_us >= fill_timestamp_us) {
-                fill_price = tick.price;
-                break;
-            }
+    std::int64_t fill_timestamp_us = applyLatency(event.timestamp_us);
+    
+    // Get market price at fill time: first tick at or after the fill timestamp
+    // (symbols without random access to their ticks are priced when the fill fires)
+    double fill_price = event.order.price;
+    if (!streamed_sources_[event.symbol]) {
+        if (const double* price = fill_pricers_[event.symbol].priceAtOrAfter(fill_timestamp_us)) {
+            fill_price = *price;
         }
-    }
-    
-    // Apply slippage: buys pay more, sells receive less
-    double slippage_factor = slippage_bps_ / 10000.0;
-    if (event->getDirection() == SignalEvent::Direction::LONG) {
-        fill_price *= (1.0 + slippage_factor);
-    } else if (event->getDirection() == SignalEvent::Direction::EXIT) {
-        fill_price *= (1.0 - slippage_factor);
+        fill_price = applySlippage(event.direction, fill_price);
     }
     
     // Per-share commission with minimum (zero if commission-free mode)
-    double quantity = event->getQuantity();
+    double quantity = event.order.quantity;
     double commission = commission_free_ ? 0.0 :
         std::max(quantity * commission_per_share_, min_commission_);
     
     // Create fill event
-    auto fill_event = std::make_unique<FillEvent>(
-        fill_timestamp_us,
-        symbol,
-        event->getDirection(),
-        quantity,
-        fill_price,
-        commission
-    );
+    EventRecord fill_event = event;
+    fill_event.type = EventType::FillEvent;
+    fill_event.timestamp_us = fill_timestamp_us;
+    fill_event.order = {quantity, fill_price, commission};
     
     // Add fill to queue
-    event_queue_.push(std::move(fill_event));
+    events_.push(fill_event);
 }
 
-void Backtester::processFillEvent(std::unique_ptr<FillEvent> event) {
-    updatePosition(*event);
+void Backtester::processFillEvent(const EventRecord& event) {
+    if (StreamedTickSource* source = streamed_sources_[event.symbol]) {
+        EventRecord fill = event;
+        if (const Tick* tick = source->firstAtOrAfter(event.timestamp_us)) {
+            fill.order.price = tick->price;
+        }
+        fill.order.price = applySlippage(fill.direction, fill.order.price);
+        updatePosition(fill);
+        return;
+    }
+    updatePosition(event);
+}
+
+double Backtester::applySlippage(SignalEvent::Direction direction, double price) const {
+    // Buys pay more, sells receive less
+    double slippage_factor = slippage_bps_ / 10000.0;
+    if (direction == SignalEvent::Direction::LONG) {
+        price *= (1.0 + slippage_factor);
+    } else if (direction == SignalEvent::Direction::EXIT) {
+        price *= (1.0 - slippage_factor);
+    }
+    return price;
 }
 
 std::int64_t Backtester::applyLatency(std::int64_t timestamp_us) const {
@@ -237,45 +534,29 @@ std::int64_t Backtester::applyLatency(std::int64_t timestamp_us) const {
     return timestamp_us + latency_us;
 }
 
-void Backtester::updatePosition(const FillEvent& fill) {
-    const std::string& symbol = fill.getSymbol();
-    
-    // Get or create position
-    if (positions_.find(symbol) == positions_.end()) {
-        Position pos;
-        pos.symbol = symbol;
-        pos.quantity = 0.0;
-        pos.avg_price = 0.0;
-        pos.total_commission = 0.0;
-        pos.direction = SignalEvent::Direction::LONG;
-        pos.entry_timestamp_us = 0;
-        pos.entry_regime = "UNKNOWN";
-        pos.strategy_name = "Unknown";
-        positions_[symbol] = pos;
-    }
-    
-    Position& position = positions_[symbol];
+void Backtester::updatePosition(const EventRecord& fill) {
+    Position& position = positions_[fill.symbol];
     
     // Handle exit signals
-    if (fill.getDirection() == SignalEvent::Direction::EXIT) {
+    if (fill.direction == SignalEvent::Direction::EXIT) {
         if (position.quantity != 0.0) {
-            closePosition(symbol, fill.getFillPrice(), fill.getTimestamp());
+            closePosition(fill.symbol, fill.order.price, fill.timestamp_us);
         }
         return;
     }
     
     // Handle entry/position building
-    if (fill.getDirection() == SignalEvent::Direction::LONG) {
+    if (fill.direction == SignalEvent::Direction::LONG) {
         if (position.quantity == 0.0) {
-            position.quantity = fill.getQuantity();
-            position.avg_price = fill.getFillPrice();
-            position.total_commission = fill.getCommission();
+            position.quantity = fill.order.quantity;
+            position.avg_price = fill.order.price;
+            position.total_commission = fill.order.commission;
             position.direction = SignalEvent::Direction::LONG;
-            position.entry_timestamp_us = fill.getTimestamp();
+            position.entry_timestamp_us = fill.timestamp_us;
 
             // Resolve actual regime string from the registered strategy
             position.entry_regime = "UNKNOWN";
-            if (strategies_.find(symbol) != strategies_.end()) {
+            if (strategies_[fill.symbol]) {
                 // Use the fill symbol to fetch regime from AI classifier via strategy name
                 // For now record the strategy type as a proxy
                 position.strategy_name = "NewsMomentum";
@@ -283,22 +564,20 @@ void Backtester::updatePosition(const FillEvent& fill) {
             }
         } else {
             double total_cost = position.avg_price * position.quantity +
-                              fill.getFillPrice() * fill.getQuantity();
-            position.quantity += fill.getQuantity();
+                              fill.order.price * fill.order.quantity;
+            position.quantity += fill.order.quantity;
             position.avg_price = total_cost / position.quantity;
-            position.total_commission += fill.getCommission();
+            position.total_commission += fill.order.commission;
         }
     }
 }
 
-void Backtester::closePosition(const std::string& symbol, double exit_price, std::int64_t timestamp_us) {
-    if (positions_.find(symbol) == positions_.end() || 
-        positions_[symbol].quantity == 0.0) {
+void Backtester::closePosition(SymbolId symbol, double exit_price, std::int64_t timestamp_us) {
+    Position& position = positions_[symbol];
+    if (position.quantity == 0.0) {
         return;
     }
     
-    Position& position = positions_[symbol];
-    
     // Calculate PnL
     double pnl = 0.0;
     if (position.direction == SignalEvent::Direction::LONG) {
@@ -310,7 +589,8 @@ void Backtester::closePosition(const std::string& symbol, double exit_price, std
     TradeRecord trade;
     trade.entry_timestamp_us = position.entry_timestamp_us;
     trade.exit_timestamp_us = timestamp_us;
-    trade.symbol = symbol;
+    trade.symbol = symbolName(symbol);
+    trade.symbol_id = symbol;
     trade.entry_price = position.avg_price;
     trade.exit_price = exit_price;
     trade.quantity = position.quantity;
@@ -323,55 +603,65 @@ void Backtester::closePosition(const std::string& symbol, double exit_price, std
     
     trade_log_.push_back(trade);
 
-    // Risk circuit breaker checks
-    double current_equity = getTotalPnL();
-    if (current_equity > peak_equity_) peak_equity_ = current_equity;
-    daily_pnl_ += trade.pnl;
+    updateRiskState(trade.pnl, timestamp_us);
+
+    position.quantity = 0.0;
+    position.avg_price = 0.0;
+    position.total_commission = 0.0;
+    position.entry_timestamp_us = 0;
+}
+
+void Backtester::rollRiskDay(std::int64_t timestamp_us) {
+    constexpr std::int64_t US_PER_DAY = 86400LL * 1'000'000LL;
+    std::int64_t day = timestamp_us / US_PER_DAY;
+    if (day == risk_.current_day) return;
+
+    risk_.current_day = day;
+    risk_.daily_pnl = 0.0;
+    risk_.halted_daily_loss = false;
+}
+
+void Backtester::updateRiskState(double pnl, std::int64_t timestamp_us) {
+    rollRiskDay(timestamp_us);
 
-    if (max_drawdown_limit_ > 0.0 && (peak_equity_ - current_equity) >= max_drawdown_limit_) {
+    risk_.num_trades++;
+    if (pnl > 0.0) risk_.num_wins++;
+    risk_.realized_equity += pnl;
+    risk_.daily_pnl += pnl;
+    if (risk_.realized_equity > risk_.peak_equity) risk_.peak_equity = risk_.realized_equity;
+    risk_.max_drawdown = std::max(risk_.max_drawdown, risk_.drawdown());
+
+    // Risk circuit breaker checks
+    if (max_drawdown_limit_ > 0.0 && !risk_.halted_drawdown &&
+        risk_.drawdown() >= max_drawdown_limit_) {
         std::cerr << "[RISK] Max drawdown limit $" << max_drawdown_limit_
                   << " reached — halting new entries.\n";
-        risk_halt_ = true;
+        risk_.halted_drawdown = true;
     }
-    if (max_daily_loss_ > 0.0 && daily_pnl_ <= -max_daily_loss_) {
+    if (max_daily_loss_ > 0.0 && !risk_.halted_daily_loss &&
+        risk_.daily_pnl <= -max_daily_loss_) {
         std::cerr << "[RISK] Daily loss limit $" << max_daily_loss_
-                  << " reached — halting new entries.\n";
-        risk_halt_ = true;
+                  << " reached — halting new entries for the day.\n";
+        risk_.halted_daily_loss = true;
     }
 
     // Consecutive loss circuit breaker
-    if (trade.pnl < 0.0) {
-        current_consec_losses_++;
-        if (max_consec_losses_ > 0 && current_consec_losses_ >= max_consec_losses_) {
-            std::cerr << "[RISK] " << current_consec_losses_
+    if (pnl < 0.0) {
+        risk_.consec_losses++;
+        if (max_consec_losses_ > 0 && !risk_.halted_consec &&
+            risk_.consec_losses >= max_consec_losses_) {
+            std::cerr << "[RISK] " << risk_.consec_losses
                       << " consecutive losses — halting new entries.\n";
-            risk_halt_ = true;
+            risk_.halted_consec = true;
         }
     } else {
-        current_consec_losses_ = 0;
+        risk_.consec_losses = 0;
     }
-
-    position.quantity = 0.0;
-    position.avg_price = 0.0;
-    position.total_commission = 0.0;
-    position.entry_timestamp_us = 0;
-}
-
-double Backtester::getTotalPnL() const {
-    double total = 0.0;
-    for (const auto& trade : trade_log_) {
-        total += trade.pnl;
-    }
-    return total;
 }
 
 double Backtester::getWinRate() const {
-    if (trade_log_.empty()) return 0.0;
-    int wins = 0;
-    for (const auto& trade : trade_log_) {
-        if (trade.pnl > 0.0) wins++;
-    }
-    return static_cast<double>(wins) / trade_log_.size() * 100.0;
+    if (risk_.num_trades == 0) return 0.0;
+    return static_cast<double>(risk_.num_wins) / risk_.num_trades * 100.0;
 }
 
 double Backtester::getAverageWin() const {
@@ -427,22 +717,6 @@ double Backtester::getSharpeRatio(double risk_free_rate) const {
     return (mean - risk_free_rate) / std_dev;
 }
 
-double Backtester::getMaxDrawdown() const {
-    if (trade_log_.empty()) return 0.0;
-
-    double peak = 0.0;
-    double equity = 0.0;
-    double max_dd = 0.0;
-
-    for (const auto& trade : trade_log_) {
-        equity += trade.pnl;
-        if (equity > peak) peak = equity;
-        double drawdown = peak - equity;
-        if (drawdown > max_dd) max_dd = drawdown;
-    }
-    return max_dd;
-}
-
 void Backtester::printPerformanceSummary() const {
     std::cout << "\n========== PERFORMANCE SUMMARY ==========\n";
     std::cout << std::fixed << std::setprecision(2);
@@ -480,10 +754,10 @@ void Backtester::printTradeLog() const {
     auto format_ts = [](std::int64_t ts_us) -> std::string {
         std::time_t t = static_cast<std::time_t>(ts_us / 1'000'000LL);
         int frac_us = static_cast<int>(ts_us % 1'000'000LL);
-        std::tm* tm_info = std::localtime(&t);
-        if (!tm_info) return std::to_string(ts_us);
+        std::tm tm_info{};
+        if (!gmtime_r(&t, &tm_info)) return std::to_string(ts_us);
         char buf[32];
-        std::strftime(buf, sizeof(buf), "%H:%M:%S", tm_info);
+        std::strftime(buf, sizeof(buf), "%H:%M:%S", &tm_info);
         char result[48];
         std::snprintf(result, sizeof(result), "%s.%06d", buf, frac_us);
         return std::string(result);
@@ -572,142 +846,5 @@ bool Backtester::exportTradeLogToJSON(const std::string& filepath) const {
     return true;
 }
 
-// TickLoader Implementation
-std::vector<Tick> TickLoader::loadFromCSV(const std::string& filepath) {
-    std::vector<Tick> ticks;
-    std::ifstream file(filepath);
-    
-    if (!file.is_open()) {
-        std::cerr << "Error: Cannot open file " << filepath << std::endl;
-        return ticks;
-    }
-    
-    std::string line;
-    bool is_first_line = true;
-    std::size_t line_num = 0;
-    std::int64_t prev_timestamp = 0;
-    std::size_t skipped = 0;
-
-    while (std::getline(file, line)) {
-        ++line_num;
-
-        if (is_first_line) {
-            is_first_line = false;
-            continue;
-        }
-
-        if (line.empty() || line[0] == '#') continue;
-
-        std::istringstream ss(line);
-        std::string field;
-        std::vector<std::string> fields;
-
-        while (std::getline(ss, field, ',')) {
-            fields.push_back(field);
-        }
-
-        // Validate column count (at least 5 required)
-        if (fields.size() < 5) {
-            std::cerr << "[WARN] Line " << line_num << ": expected 5 columns, got "
-                      << fields.size() << " — skipping\n";
-            ++skipped;
-            continue;
-        }
-
-        Tick tick;
-        try {
-            tick.timestamp_us = parseTimestamp(fields[0]);
-            tick.price        = std::stod(fields[1]);
-            tick.volume       = std::stoll(fields[2]);
-            tick.bid_size     = std::stod(fields[3]);
-            tick.ask_size     = std::stod(fields[4]);
-            tick.high         = (fields.size() > 5) ? std::stod(fields[5]) : tick.price;
-            tick.low          = (fields.size() > 6) ? std::stod(fields[6]) : tick.price;
-        } catch (const std::exception& e) {
-            std::cerr << "[WARN] Line " << line_num << ": parse error (" << e.what()
-                      << ") — skipping\n";
-            ++skipped;
-            continue;
-        }
-
-        // Data sanity: price and volume must be positive
-        if (tick.price <= 0.0 || tick.volume < 0) {
-            std::cerr << "[WARN] Line " << line_num << ": invalid price/volume — skipping\n";
-            ++skipped;
-            continue;
-        }
-
-        // Warn on non-monotonic timestamps but keep the tick
-        if (prev_timestamp > 0 && tick.timestamp_us < prev_timestamp) {
-            std::cerr << "[WARN] Line " << line_num << ": non-monotonic timestamp\n";
-        }
-        prev_timestamp = tick.timestamp_us;
-
-        ticks.push_back(tick);
-    }
-
-    if (skipped > 0) {
-        std::cerr << "[INFO] Skipped " << skipped << " malformed rows.\n";
-    }
-    
-    file.close();
-    std::cout << "Loaded " << ticks.size() << " ticks from " << filepath << std::endl;
-    
-    return ticks;
-}
-
-std::int64_t TickLoader::parseTimestamp(const std::string& ts_str) {
-    if (ts_str.empty()) return 0;
-
-    // Try integer microseconds first (fastest path)
-    try {
-        bool all_digits = true;
-        for (char c : ts_str) {
-            if (!std::isdigit(c)) { all_digits = false; break; }
-        }
-        if (all_digits) return std::stoll(ts_str);
-    } catch (...) {}
-
-    // Try ISO 8601 format: YYYY-MM-DDTHH:MM:SS[.ffffff][Z]
-    // e.g., "2024-01-15T09:30:00.123456"
-    std::tm tm = {};
-    int microseconds = 0;
-    const char* fmt_full  = "%Y-%m-%dT%H:%M:%S";
-    const char* fmt_space = "%Y-%m-%d %H:%M:%S";
-
-    char* parsed = nullptr;
-    for (const char* fmt : {fmt_full, fmt_space}) {
-        std::string stripped = ts_str;
-        // strip trailing Z
-        if (!stripped.empty() && stripped.back() == 'Z') stripped.pop_back();
-
-        parsed = strptime(stripped.c_str(), fmt, &tm);
-        if (parsed) {
-            // parse optional fractional seconds
-            if (*parsed == '.' || *parsed == ',') {
-                ++parsed;
-                int frac = 0, digits = 0;
-                while (*parsed && std::isdigit(*parsed) && digits < 6) {
-                    frac = frac * 10 + (*parsed - '0');
-                    ++parsed;
-                    ++digits;
-                }
-                // pad to 6 digits
-                while (digits++ < 6) frac *= 10;
-                microseconds = frac;
-            }
-            break;
-        }
-    }
-
-    if (!parsed) return 0;
-
-    tm.tm_isdst = -1;
-    std::time_t epoch_sec = std::mktime(&tm);
-    if (epoch_sec == -1) return 0;
-
-    return static_cast<std::int64_t>(epoch_sec) * 1'000'000LL + microseconds;
-}
-
 } // namespace AlgoCatalyst
 
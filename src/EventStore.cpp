@@ -0,0 +1,79 @@
+#include "EventStore.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace AlgoCatalyst {
+
+void EventStore::reserve(std::size_t capacity) {
+    while (this->capacity() < capacity) {
+        addSlab();
+    }
+    scheduler_->reserve(capacity);
+}
+
+void EventStore::addSlab() {
+    Slot base = static_cast<Slot>(capacity());
+    slabs_.push_back(std::make_unique<EventRecord[]>(kSlabSize));
+    stats_.allocations++;
+
+    if (free_slots_.capacity() < capacity()) {
+        free_slots_.reserve(capacity());
+        stats_.allocations++;
+    }
+    // Push in reverse so low slot numbers are handed out first
+    for (std::size_t i = kSlabSize; i-- > 0;) {
+        free_slots_.push_back(base + static_cast<Slot>(i));
+    }
+}
+
+void EventStore::push(const EventRecord& record) {
+    if (free_slots_.empty()) {
+        addSlab();
+    }
+    // Schedule before claiming the slot so a rejected push leaks nothing
+    Slot s = free_slots_.back();
+    ScheduledKey key{record.timestamp_us, next_seq_++, s};
+    try {
+        scheduler_->push(key);
+    } catch (const std::invalid_argument&) {
+        if (scheduler_->kind() != SchedulerKind::RadixHeap) throw;
+        fallBackToBinaryHeap();
+        scheduler_->push(key);
+    }
+    free_slots_.pop_back();
+    slot(s) = record;
+
+    stats_.pushed++;
+    stats_.live = scheduler_->size();
+    stats_.peak_live = std::max(stats_.peak_live, stats_.live);
+}
+
+EventRecord EventStore::pop() {
+    Slot s = scheduler_->pop().slot;
+
+    EventRecord record = slot(s);
+    free_slots_.push_back(s);
+    stats_.live = scheduler_->size();
+    return record;
+}
+
+void EventStore::fallBackToBinaryHeap() {
+    // Keys keep their sequence numbers, so equal timestamps still pop FIFO
+    auto binary = makeScheduler(SchedulerKind::BinaryHeap);
+    binary->reserve(scheduler_->size());
+    while (!scheduler_->empty()) {
+        binary->push(scheduler_->pop());
+    }
+    stats_.allocations += scheduler_->allocations();
+    stats_.fallbacks++;
+    scheduler_ = std::move(binary);
+}
+
+void EventStore::clear() {
+    while (!scheduler_->empty()) {
+        free_slots_.push_back(scheduler_->pop().slot);
+    }
+    stats_.live = 0;
+}
+
+} // namespace AlgoCatalyst
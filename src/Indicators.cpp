@@ -1,45 +1,24 @@
 #include "Indicators.h"
 #include <cmath>
 #include <algorithm>
-#include <numeric>
 
 namespace AlgoCatalyst {
 
 Indicators::Indicators()
-    : ema_12_(0.0), ema_26_(0.0), macd_signal_ema_9_(0.0), macd_tick_count_(0),
+    : macd_histogram_history_(11),
       bb_upper_(0.0), bb_middle_(0.0), bb_lower_(0.0), bb_period_(20), bb_std_dev_mult_(2.0),
       cumulative_price_volume_(0.0), cumulative_volume_(0),
-      vwap_session_start_us_(0), prev_close_(0.0), current_price_(0.0),
+      vwap_session_start_us_(0), volume_history_(21), prev_close_(0.0), current_price_(0.0),
       open_price_(0.0), is_first_tick_(true) {
 }
 
 void Indicators::updateEMA(double price, std::size_t period) {
-    auto it = emas_.find(period);
-    
-    if (it == emas_.end()) {
-        double alpha = 2.0 / (period + 1.0);
-        emas_[period] = {price, alpha, 1};
-    } else {
-        EMAState& state = it->second;
-        state.tick_count++;
-        // Use SMA for the first 'period' ticks for a proper warm-up
-        if (state.tick_count <= period) {
-            state.value = state.value + (price - state.value) / state.tick_count;
-        } else {
-            state.value = state.alpha * price + (1.0 - state.alpha) * state.value;
-        }
-    }
+    emas_[period].update(price, period);
 }
 
 double Indicators::getEMA(std::size_t period) const {
     auto it = emas_.find(period);
-    if (it != emas_.end()) {
-        // Only return EMA after warm-up period
-        if (it->second.tick_count >= period) {
-            return it->second.value;
-        }
-    }
-    return 0.0;
+    return it != emas_.end() ? it->second.get(period) : 0.0;
 }
 
 bool Indicators::isPriceAboveEMA(double price, std::size_t period) const {
@@ -48,39 +27,10 @@ bool Indicators::isPriceAboveEMA(double price, std::size_t period) const {
 }
 
 void Indicators::updateMACD(double price) {
-    macd_tick_count_++;
-
-    // SMA warm-up for 12-EMA
-    if (macd_tick_count_ == 1) {
-        ema_12_ = price;
-        ema_26_ = price;
-    } else if (macd_tick_count_ <= 12) {
-        ema_12_ += (price - ema_12_) / macd_tick_count_;
-        ema_26_ += (price - ema_26_) / macd_tick_count_;
-    } else if (macd_tick_count_ <= 26) {
-        double alpha_12 = 2.0 / (12.0 + 1.0);
-        ema_12_ = alpha_12 * price + (1.0 - alpha_12) * ema_12_;
-        ema_26_ += (price - ema_26_) / macd_tick_count_;
-    } else {
-        double alpha_12 = 2.0 / (12.0 + 1.0);
-        double alpha_26 = 2.0 / (26.0 + 1.0);
-        ema_12_ = alpha_12 * price + (1.0 - alpha_12) * ema_12_;
-        ema_26_ = alpha_26 * price + (1.0 - alpha_26) * ema_26_;
-    }
-
-    // Only compute signal / histogram after 26-tick warm-up
-    if (macd_tick_count_ < 26) return;
-
-    double macd_line = ema_12_ - ema_26_;
-
-    if (macd_tick_count_ == 26) {
-        macd_signal_ema_9_ = macd_line;
-    } else {
-        double alpha_9 = 2.0 / (9.0 + 1.0);
-        macd_signal_ema_9_ = alpha_9 * macd_line + (1.0 - alpha_9) * macd_signal_ema_9_;
-    }
+    // Only record the histogram after the 26-tick warm-up
+    if (!macd_.update(price)) return;
 
-    double histogram = macd_line - macd_signal_ema_9_;
+    double histogram = macd_.macd() - macd_.signal;
     macd_histogram_history_.push_back(histogram);
     if (macd_histogram_history_.size() > 10) {
         macd_histogram_history_.pop_front();
@@ -88,11 +38,11 @@ void Indicators::updateMACD(double price) {
 }
 
 double Indicators::getMACD() const {
-    return ema_12_ - ema_26_;
+    return macd_.macd();
 }
 
 double Indicators::getMACDSignal() const {
-    return macd_signal_ema_9_;
+    return macd_.signal;
 }
 
 double Indicators::getMACDHistogram() const {
@@ -104,56 +54,20 @@ bool Indicators::isMACDHistogramExpanding() const {
     if (macd_histogram_history_.size() < 2) return false;
     
     // Check if histogram is increasing (last value > previous value)
-    auto it = macd_histogram_history_.rbegin();
-    double current = *it;
-    double previous = *(++it);
+    std::size_t n = macd_histogram_history_.size();
+    double current = macd_histogram_history_[n - 1];
+    double previous = macd_histogram_history_[n - 2];
     
     return current > previous;
 }
 
 void Indicators::updateRSI(double price, std::size_t period) {
-    auto it = rsi_states_.find(period);
-    
-    if (it == rsi_states_.end()) {
-        RSIState state;
-        state.avg_gain = 0.0;
-        state.avg_loss = 0.0;
-        state.prev_price = price;
-        state.tick_count = 1;
-        rsi_states_[period] = state;
-        return;
-    }
-    
-    RSIState& state = it->second;
-    double change = price - state.prev_price;
-    double gain = (change > 0.0) ? change : 0.0;
-    double loss = (change < 0.0) ? -change : 0.0;
-    
-    state.tick_count++;
-    
-    if (state.tick_count <= period) {
-        // Accumulate initial averages via SMA
-        state.avg_gain += (gain - state.avg_gain) / state.tick_count;
-        state.avg_loss += (loss - state.avg_loss) / state.tick_count;
-    } else {
-        // Wilder smoothing
-        double alpha = 1.0 / period;
-        state.avg_gain = alpha * gain + (1.0 - alpha) * state.avg_gain;
-        state.avg_loss = alpha * loss + (1.0 - alpha) * state.avg_loss;
-    }
-    
-    state.prev_price = price;
+    rsi_states_[period].update(price, period);
 }
 
 double Indicators::getRSI(std::size_t period) const {
     auto it = rsi_states_.find(period);
-    if (it == rsi_states_.end() || it->second.tick_count < period) return 50.0;
-    
-    const RSIState& state = it->second;
-    if (state.avg_loss == 0.0) return 100.0;
-    
-    double rs = state.avg_gain / state.avg_loss;
-    return 100.0 - (100.0 / (1.0 + rs));
+    return it != rsi_states_.end() ? it->second.get(period) : 50.0;
 }
 
 bool Indicators::isOversold(std::size_t period, double threshold) const {
@@ -255,39 +169,12 @@ double Indicators::getGapUpPercent() const {
 }
 
 void Indicators::updateATR(double high, double low, double close, std::size_t period) {
-    auto it = atr_states_.find(period);
-
-    if (it == atr_states_.end()) {
-        ATRState state;
-        state.atr = high - low;
-        state.prev_close = close;
-        state.tick_count = 1;
-        atr_states_[period] = state;
-        return;
-    }
-
-    ATRState& state = it->second;
-    state.tick_count++;
-
-    double tr = std::max({high - low,
-                          std::abs(high - state.prev_close),
-                          std::abs(low - state.prev_close)});
-
-    if (state.tick_count <= period) {
-        // SMA warm-up
-        state.atr += (tr - state.atr) / state.tick_count;
-    } else {
-        // Wilder smoothing
-        state.atr = (state.atr * (period - 1) + tr) / period;
-    }
-
-    state.prev_close = close;
+    atr_states_[period].update(high, low, close, period);
 }
 
 double Indicators::getATR(std::size_t period) const {
     auto it = atr_states_.find(period);
-    if (it == atr_states_.end() || it->second.tick_count < period) return 0.0;
-    return it->second.atr;
+    return it != atr_states_.end() ? it->second.get(period) : 0.0;
 }
 
 double Indicators::getATRPercent(double price, std::size_t period) const {
@@ -297,26 +184,21 @@ double Indicators::getATRPercent(double price, std::size_t period) const {
 
 void Indicators::updateStochastic(double high, double low, double close,
                                    std::size_t k_period, std::size_t d_period) {
-    stoch_highs_.push_back(high);
-    stoch_lows_.push_back(low);
-    if (stoch_highs_.size() > k_period) stoch_highs_.pop_front();
-    if (stoch_lows_.size()  > k_period) stoch_lows_.pop_front();
+    stoch_range_.setPeriod(k_period);
+    stoch_range_.push(high, low);
 
-    if (stoch_highs_.size() < k_period) return;
+    if (!stoch_range_.full()) return;
 
-    double highest = *std::max_element(stoch_highs_.begin(), stoch_highs_.end());
-    double lowest  = *std::min_element(stoch_lows_.begin(),  stoch_lows_.end());
+    double highest = stoch_range_.max();
+    double lowest  = stoch_range_.min();
 
     stoch_k_ = (highest == lowest) ? 50.0 :
                100.0 * (close - lowest) / (highest - lowest);
 
-    stoch_k_history_.push_back(stoch_k_);
-    if (stoch_k_history_.size() > d_period) stoch_k_history_.pop_front();
-
     // %D = simple average of last d_period %K values
-    double sum_k = 0.0;
-    for (double k : stoch_k_history_) sum_k += k;
-    stoch_d_ = sum_k / stoch_k_history_.size();
+    stoch_k_window_.setPeriod(d_period);
+    stoch_k_window_.push(stoch_k_);
+    stoch_d_ = stoch_k_window_.mean();
 }
 
 double Indicators::getStochasticK() const { return stoch_k_; }
@@ -333,6 +215,7 @@ bool Indicators::isStochasticOverbought(double threshold) const {
 // ── WMA ─────────────────────────────────────────────────────────────────────
 void Indicators::updateWMA(double price, std::size_t period) {
     auto& window = wma_windows_[period];
+    window.reserve(period + 1);
     window.push_back(price);
     if (window.size() > period) window.pop_front();
 }
@@ -354,11 +237,13 @@ double Indicators::getWMA(std::size_t period) const {
 }
 
 // ── OBV ─────────────────────────────────────────────────────────────────────
-void Indicators::updateOBV(double price, std::int64_t volume) {
+void Indicators::updateOBV(double price, std::int64_t volume, std::size_t ema_period) {
+    obv_ema_period_ = ema_period;
     if (!obv_initialized_) {
         obv_prev_price_ = price;
         obv_initialized_ = true;
-        obv_history_.push_back(obv_value_);
+        obv_ema_ = obv_value_;
+        obv_count_ = 1;
         return;
     }
 
@@ -366,33 +251,27 @@ void Indicators::updateOBV(double price, std::int64_t volume) {
     else if (price < obv_prev_price_)  obv_value_ -= volume;
 
     obv_prev_price_ = price;
-    obv_history_.push_back(obv_value_);
-    if (obv_history_.size() > 200) obv_history_.pop_front();
+    // EMA seeded with the first OBV value
+    double alpha = 2.0 / (ema_period + 1.0);
+    obv_ema_ = alpha * obv_value_ + (1.0 - alpha) * obv_ema_;
+    obv_count_++;
 }
 
 double Indicators::getOBV() const { return obv_value_; }
 
-double Indicators::getOBVEMA(std::size_t period) const {
-    if (obv_history_.size() < period) return obv_value_;
-    double ema = obv_history_.front();
-    double alpha = 2.0 / (period + 1.0);
-    for (double v : obv_history_) {
-        ema = alpha * v + (1.0 - alpha) * ema;
-    }
-    return ema;
+double Indicators::getOBVEMA() const {
+    return obv_count_ < obv_ema_period_ ? obv_value_ : obv_ema_;
 }
 
 // ── Williams %R ──────────────────────────────────────────────────────────────
 void Indicators::updateWilliamsR(double high, double low, double close, std::size_t period) {
-    wr_highs_.push_back(high);
-    wr_lows_.push_back(low);
-    if (wr_highs_.size() > period) wr_highs_.pop_front();
-    if (wr_lows_.size()  > period) wr_lows_.pop_front();
+    wr_range_.setPeriod(period);
+    wr_range_.push(high, low);
 
-    if (wr_highs_.size() < period) return;
+    if (!wr_range_.full()) return;
 
-    double highest = *std::max_element(wr_highs_.begin(), wr_highs_.end());
-    double lowest  = *std::min_element(wr_lows_.begin(),  wr_lows_.end());
+    double highest = wr_range_.max();
+    double lowest  = wr_range_.min();
 
     williams_r_ = (highest == lowest) ? -50.0 :
                   -100.0 * (highest - close) / (highest - lowest);
@@ -410,15 +289,13 @@ bool Indicators::isWilliamsROverbought(double threshold) const {
 
 // ── Donchian Channel ─────────────────────────────────────────────────────────
 void Indicators::updateDonchian(double high, double low, std::size_t period) {
-    dc_highs_.push_back(high);
-    dc_lows_.push_back(low);
-    if (dc_highs_.size() > period) dc_highs_.pop_front();
-    if (dc_lows_.size()  > period) dc_lows_.pop_front();
+    dc_range_.setPeriod(period);
+    dc_range_.push(high, low);
 
-    if (dc_highs_.size() < period) return;
+    if (!dc_range_.full()) return;
 
-    dc_upper_ = *std::max_element(dc_highs_.begin(), dc_highs_.end());
-    dc_lower_ = *std::min_element(dc_lows_.begin(),  dc_lows_.end());
+    dc_upper_ = dc_range_.max();
+    dc_lower_ = dc_range_.min();
 }
 
 double Indicators::getDonchianUpper() const { return dc_upper_; }
@@ -435,56 +312,27 @@ bool Indicators::isPriceBelowDonchianLower(double price) const {
 
 // ── DEMA ─────────────────────────────────────────────────────────────────────
 void Indicators::updateDEMA(double price, std::size_t period) {
-    auto it = dema_states_.find(period);
-    if (it == dema_states_.end()) {
-        DEMAState s;
-        s.ema1 = price;
-        s.ema2 = price;
-        s.alpha = 2.0 / (period + 1.0);
-        s.tick_count = 1;
-        dema_states_[period] = s;
-        return;
-    }
-
-    DEMAState& s = it->second;
-    s.tick_count++;
-
-    if (s.tick_count <= period) {
-        s.ema1 += (price - s.ema1) / s.tick_count;
-        s.ema2 += (s.ema1 - s.ema2) / s.tick_count;
-    } else {
-        s.ema1 = s.alpha * price + (1.0 - s.alpha) * s.ema1;
-        s.ema2 = s.alpha * s.ema1 + (1.0 - s.alpha) * s.ema2;
-    }
+    dema_states_[period].update(price, period);
 }
 
 double Indicators::getDEMA(std::size_t period) const {
     auto it = dema_states_.find(period);
-    if (it == dema_states_.end() || it->second.tick_count < period) return 0.0;
-    const DEMAState& s = it->second;
-    return 2.0 * s.ema1 - s.ema2;
+    return it != dema_states_.end() ? it->second.get(period) : 0.0;
 }
 
 // ── CCI ──────────────────────────────────────────────────────────────────────
 void Indicators::updateCCI(double high, double low, double close, std::size_t period) {
     double typical = (high + low + close) / 3.0;
 
-    cci_highs_.push_back(high);
-    cci_lows_.push_back(low);
-    cci_closes_.push_back(typical);
-
-    if (cci_closes_.size() > period) {
-        cci_highs_.pop_front();
-        cci_lows_.pop_front();
-        cci_closes_.pop_front();
-    }
-
-    if (cci_closes_.size() < period) return;
+    cci_typical_.setPeriod(period);
+    cci_typical_.push(typical);
+    if (!cci_typical_.full()) return;
 
-    double mean_tp = std::accumulate(cci_closes_.begin(), cci_closes_.end(), 0.0) / period;
+    double mean_tp = cci_typical_.mean();
 
+    // Every deviation changes with the mean, so this pass stays O(period)
     double mean_dev = 0.0;
-    for (double tp : cci_closes_) mean_dev += std::abs(tp - mean_tp);
+    for (double tp : cci_typical_) mean_dev += std::abs(tp - mean_tp);
     mean_dev /= period;
 
     cci_value_ = (mean_dev == 0.0) ? 0.0 : (typical - mean_tp) / (0.015 * mean_dev);
@@ -501,18 +349,15 @@ void Indicators::updateCMF(double high, double low, double close,
     double mfm = (range == 0.0) ? 0.0 : ((close - low) - (high - close)) / range;
     double mfv = mfm * volume;
 
-    cmf_bars_.push_back({mfv, volume});
-    if (cmf_bars_.size() > period) cmf_bars_.pop_front();
+    cmf_mfv_.setPeriod(period);
+    cmf_volume_.setPeriod(period);
+    cmf_mfv_.push(mfv);
+    cmf_volume_.push(static_cast<double>(volume));
 
-    if (cmf_bars_.size() < period) return;
+    if (!cmf_mfv_.full()) return;
 
-    double sum_mfv = 0.0;
-    std::int64_t sum_vol = 0;
-    for (const auto& b : cmf_bars_) {
-        sum_mfv += b.mfv;
-        sum_vol += b.volume;
-    }
-    cmf_value_ = (sum_vol == 0) ? 0.0 : sum_mfv / sum_vol;
+    double sum_vol = cmf_volume_.sum();
+    cmf_value_ = (sum_vol == 0.0) ? 0.0 : cmf_mfv_.sum() / sum_vol;
 }
 
 double Indicators::getCMF() const { return cmf_value_; }
@@ -520,22 +365,13 @@ double Indicators::getCMF() const { return cmf_value_; }
 void Indicators::updateBollingerBands(double price, std::size_t period, double std_dev_mult) {
     bb_period_ = period;
     bb_std_dev_mult_ = std_dev_mult;
-    bb_price_history_.push_back(price);
-
-    if (bb_price_history_.size() > period) {
-        bb_price_history_.pop_front();
-    }
+    bb_prices_.setPeriod(period);
+    bb_prices_.push(price);
 
-    if (bb_price_history_.size() < period) return;
+    if (!bb_prices_.full()) return;
 
-    double mean = std::accumulate(bb_price_history_.begin(), bb_price_history_.end(), 0.0) / period;
-
-    double variance = 0.0;
-    for (double p : bb_price_history_) {
-        double diff = p - mean;
-        variance += diff * diff;
-    }
-    double std_dev = std::sqrt(variance / period);
+    double mean = bb_prices_.mean();
+    double std_dev = bb_prices_.stddev();
 
     bb_middle_ = mean;
     bb_upper_ = mean + std_dev_mult * std_dev;
@@ -561,17 +397,13 @@ bool Indicators::isPriceBelowLowerBand() const {
 
 void Indicators::reset() {
     emas_.clear();
-    ema_12_ = 0.0;
-    ema_26_ = 0.0;
-    macd_signal_ema_9_ = 0.0;
-    macd_tick_count_ = 0;
+    macd_ = MACDState{};
     macd_histogram_history_.clear();
     rsi_states_.clear();
     atr_states_.clear();
-    bb_price_history_.clear();
-    stoch_highs_.clear();
-    stoch_lows_.clear();
-    stoch_k_history_.clear();
+    bb_prices_.clear();
+    stoch_range_.clear();
+    stoch_k_window_.clear();
     stoch_k_ = 50.0;
     stoch_d_ = 50.0;
     bb_upper_ = 0.0;
@@ -581,26 +413,25 @@ void Indicators::reset() {
     obv_value_ = 0.0;
     obv_prev_price_ = 0.0;
     obv_initialized_ = false;
-    obv_history_.clear();
-    wr_highs_.clear();
-    wr_lows_.clear();
+    obv_ema_ = 0.0;
+    obv_count_ = 0;
+    wr_range_.clear();
     williams_r_ = -50.0;
-    dc_highs_.clear();
-    dc_lows_.clear();
+    dc_range_.clear();
     dc_upper_ = 0.0;
     dc_lower_ = 0.0;
     dema_states_.clear();
-    cci_highs_.clear();
-    cci_lows_.clear();
-    cci_closes_.clear();
+    cci_typical_.clear();
     cci_value_ = 0.0;
-    cmf_bars_.clear();
+    cmf_mfv_.clear();
+    cmf_volume_.clear();
     cmf_value_ = 0.0;
     trix_states_.clear();
     trix_value_ = 0.0;
     adx_state_ = ADXState{};
     adx_value_ = plus_di_ = minus_di_ = 0.0;
-    mfi_bars_.clear();
+    mfi_pos_flow_.clear();
+    mfi_neg_flow_.clear();
     mfi_prev_typical_ = 0.0;
     mfi_value_ = 50.0;
     kama_value_ = 0.0;
@@ -620,30 +451,9 @@ void Indicators::reset() {
 
 // ── TRIX ─────────────────────────────────────────────────────────────────────
 void Indicators::updateTRIX(double price, std::size_t period) {
-    auto it = trix_states_.find(period);
-    if (it == trix_states_.end()) {
-        TRIXState s;
-        s.ema1 = s.ema2 = s.ema3 = price;
-        s.alpha = 2.0 / (period + 1.0);
-        s.prev_ema3 = price;
-        s.tick_count = 1;
-        trix_states_[period] = s;
-        return;
-    }
-    TRIXState& s = it->second;
-    s.tick_count++;
-    if (s.tick_count <= period) {
-        s.ema1 += (price   - s.ema1) / s.tick_count;
-        s.ema2 += (s.ema1  - s.ema2) / s.tick_count;
-        s.ema3 += (s.ema2  - s.ema3) / s.tick_count;
-    } else {
-        s.ema1 = s.alpha * price  + (1.0 - s.alpha) * s.ema1;
-        s.ema2 = s.alpha * s.ema1 + (1.0 - s.alpha) * s.ema2;
-        s.ema3 = s.alpha * s.ema2 + (1.0 - s.alpha) * s.ema3;
-    }
-    trix_value_ = s.prev_ema3 != 0.0 ?
-        (s.ema3 - s.prev_ema3) / s.prev_ema3 * 100.0 : 0.0;
-    s.prev_ema3 = s.ema3;
+    TRIXState& s = trix_states_[period];
+    s.update(price, period);
+    if (s.tick_count > 1) trix_value_ = s.value;
 }
 
 double Indicators::getTRIX() const { return trix_value_; }
@@ -707,20 +517,20 @@ void Indicators::updateMFI(double high, double low, double close,
     double tp = (high + low + close) / 3.0;
     double raw = tp * volume;
 
+    mfi_pos_flow_.setPeriod(period);
+    mfi_neg_flow_.setPeriod(period);
     if (mfi_prev_typical_ > 0.0) {
-        mfi_bars_.push_back({tp, tp >= mfi_prev_typical_ ? raw : -raw});
+        bool up = tp >= mfi_prev_typical_;
+        mfi_pos_flow_.push(up ? raw : 0.0);
+        mfi_neg_flow_.push(up ? 0.0 : raw);
     }
     mfi_prev_typical_ = tp;
 
-    if (mfi_bars_.size() > period) mfi_bars_.pop_front();
-    if (mfi_bars_.size() < period) return;
+    if (!mfi_pos_flow_.full()) return;
 
-    double pos_mf = 0.0, neg_mf = 0.0;
-    for (const auto& b : mfi_bars_) {
-        if (b.raw_mf >= 0.0) pos_mf += b.raw_mf;
-        else                  neg_mf += std::abs(b.raw_mf);
-    }
-    mfi_value_ = neg_mf == 0.0 ? 100.0 : 100.0 - 100.0 / (1.0 + pos_mf / neg_mf);
+    double pos_mf = mfi_pos_flow_.sum();
+    double neg_mf = mfi_neg_flow_.sum();
+    mfi_value_ = neg_mf <= 0.0 ? 100.0 : 100.0 - 100.0 / (1.0 + pos_mf / neg_mf);
 }
 
 double Indicators::getMFI() const { return mfi_value_; }
@@ -730,6 +540,7 @@ bool   Indicators::isMFIOverbought(double t) const { return mfi_value_ > t; }
 // ── KAMA ─────────────────────────────────────────────────────────────────────
 void Indicators::updateKAMA(double price, std::size_t er_period,
                              double fast_sc, double slow_sc) {
+    kama_prices_.reserve(er_period + 2);
     kama_prices_.push_back(price);
     if (kama_prices_.size() > er_period + 1) kama_prices_.pop_front();
 
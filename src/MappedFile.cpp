@@ -0,0 +1,65 @@
+#include "MappedFile.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+namespace AlgoCatalyst {
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      is_open_(std::exchange(other.is_open_, false)) {
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        is_open_ = std::exchange(other.is_open_, false);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    if (st.st_size > 0) {
+        void* addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        // Loaders scan front to back once; let the kernel read ahead aggressively
+        ::madvise(addr, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(addr);
+        size_ = static_cast<std::size_t>(st.st_size);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(fd);
+    is_open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    is_open_ = false;
+}
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,171 @@
+#include "Scheduler.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace AlgoCatalyst {
+
+namespace {
+
+// std::*_heap builds a max-heap; invert so the earliest (then oldest) key is on top
+struct Later {
+    bool operator()(const ScheduledKey& a, const ScheduledKey& b) const {
+        if (a.timestamp_us != b.timestamp_us) return a.timestamp_us > b.timestamp_us;
+        return a.seq > b.seq;
+    }
+};
+
+} // namespace
+
+const char* schedulerName(SchedulerKind kind) {
+    switch (kind) {
+        case SchedulerKind::BinaryHeap: return "binary-heap";
+        case SchedulerKind::RadixHeap:  return "radix-heap";
+        case SchedulerKind::Auto:       return "auto";
+    }
+    return "unknown";
+}
+
+std::unique_ptr<Scheduler> makeScheduler(SchedulerKind kind) {
+    if (kind == SchedulerKind::RadixHeap) {
+        return std::make_unique<RadixHeapScheduler>();
+    }
+    return std::make_unique<BinaryHeapScheduler>();
+}
+
+// ── BinaryHeapScheduler ───────────────────────────────────────────────────────
+void BinaryHeapScheduler::reserve(std::size_t capacity) {
+    if (heap_.capacity() < capacity) {
+        heap_.reserve(capacity);
+        allocations_++;
+    }
+}
+
+void BinaryHeapScheduler::push(const ScheduledKey& key) {
+    if (heap_.size() == heap_.capacity()) {
+        allocations_++;
+    }
+    heap_.push_back(key);
+    std::push_heap(heap_.begin(), heap_.end(), Later{});
+}
+
+ScheduledKey BinaryHeapScheduler::pop() {
+    std::pop_heap(heap_.begin(), heap_.end(), Later{});
+    ScheduledKey key = heap_.back();
+    heap_.pop_back();
+    return key;
+}
+
+// ── RadixHeapScheduler ────────────────────────────────────────────────────────
+void RadixHeapScheduler::reserve(std::size_t capacity) {
+    for (auto& bucket : buckets_) {
+        if (bucket.capacity() < capacity) {
+            bucket.reserve(capacity);
+            allocations_++;
+        }
+    }
+}
+
+std::size_t RadixHeapScheduler::bucketFor(std::uint64_t r) const {
+    return r == last_ ? 0 : static_cast<std::size_t>(std::bit_width(r ^ last_));
+}
+
+void RadixHeapScheduler::append(std::size_t bucket, const ScheduledKey& key) {
+    auto& b = buckets_[bucket];
+    if (b.size() == b.capacity()) {
+        allocations_++;
+    }
+    b.push_back(key);
+}
+
+void RadixHeapScheduler::push(const ScheduledKey& key) {
+    std::uint64_t r = radix(key.timestamp_us);
+    if (size_ == 0) {
+        // Nothing queued: an earlier timestamp may start a new monotone run
+        last_ = std::min(last_, r);
+        head_ = 0;
+        buckets_[0].clear();
+        min_valid_ = false;
+    } else if (r < last_) {
+        throw std::invalid_argument("RadixHeapScheduler: event scheduled before the last dispatched event");
+    }
+
+    std::size_t bucket = bucketFor(r);
+    append(bucket, key);
+    size_++;
+
+    if (bucket != 0 && min_valid_ && Later{}(min_key_, key)) {
+        min_key_ = key;
+    }
+}
+
+std::size_t RadixHeapScheduler::lowestBucket() const {
+    std::size_t i = 1;
+    while (buckets_[i].empty()) ++i;
+    return i;
+}
+
+const ScheduledKey& RadixHeapScheduler::minOutsideFront() {
+    if (!min_valid_) {
+        const auto& bucket = buckets_[lowestBucket()];
+        min_key_ = *std::min_element(bucket.begin(), bucket.end(),
+            [](const ScheduledKey& a, const ScheduledKey& b) { return Later{}(b, a); });
+        min_valid_ = true;
+    }
+    return min_key_;
+}
+
+const ScheduledKey& RadixHeapScheduler::top() {
+    if (head_ < buckets_[0].size()) return buckets_[0][head_];
+    return minOutsideFront();
+}
+
+void RadixHeapScheduler::refill() {
+    buckets_[0].clear();
+    head_ = 0;
+
+    std::size_t from = lowestBucket();
+    last_ = radix(minOutsideFront().timestamp_us);
+    min_valid_ = false;
+
+    // Every key in 'from' now differs from last_ only below bit 'from - 1', so
+    // each lands in a strictly lower bucket
+    auto moving = std::move(buckets_[from]);
+    buckets_[from].clear();
+    for (const ScheduledKey& key : moving) {
+        append(bucketFor(radix(key.timestamp_us)), key);
+    }
+    // Hand the storage back so the bucket does not reallocate next time
+    moving.clear();
+    buckets_[from].swap(moving);
+
+    // 'from' mixed direct pushes with keys moved down from higher buckets, so
+    // restore FIFO order among the ties now in bucket 0
+    std::sort(buckets_[0].begin(), buckets_[0].end(),
+              [](const ScheduledKey& a, const ScheduledKey& b) { return a.seq < b.seq; });
+}
+
+ScheduledKey RadixHeapScheduler::pop() {
+    if (head_ == buckets_[0].size()) {
+        refill();
+    }
+    ScheduledKey key = buckets_[0][head_++];
+    size_--;
+    if (head_ == buckets_[0].size()) {
+        buckets_[0].clear();
+        head_ = 0;
+    }
+    return key;
+}
+
+void RadixHeapScheduler::clear() {
+    for (auto& bucket : buckets_) {
+        bucket.clear();
+    }
+    head_ = 0;
+    size_ = 0;
+    last_ = 0;
+    min_valid_ = false;
+}
+
+} // namespace AlgoCatalyst
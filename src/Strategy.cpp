@@ -7,7 +7,25 @@ namespace AlgoCatalyst {
 
 // Base Strategy Implementation
 Strategy::Strategy(const std::string& symbol)
-    : symbol_(symbol), position_(0.0), avg_fill_price_(0.0) {
+    : symbol_(symbol), symbol_id_(internSymbol(symbol)), position_(0.0), avg_fill_price_(0.0) {
+}
+
+std::vector<EventPtr> Strategy::processMarketUpdate(const MarketUpdateEvent& event) {
+    SignalEmitter out;
+    onMarketUpdate(event.getTick(), out);
+
+    std::vector<EventPtr> signals;
+    for (const Signal& sig : out) {
+        signals.push_back(std::make_unique<SignalEvent>(
+            sig.timestamp_us, sig.symbol, sig.direction, sig.quantity, sig.price));
+    }
+    return signals;
+}
+
+void Strategy::reset() {
+    position_ = 0.0;
+    avg_fill_price_ = 0.0;
+    indicators_.reset();
 }
 
 // News Momentum Strategy Implementation
@@ -16,11 +34,25 @@ NewsMomentumStrategy::NewsMomentumStrategy(const std::string& symbol, RegimeClas
       was_long_ema_above_short_(false), entry_timestamp_us_(0) {
 }
 
-std::vector<EventPtr> NewsMomentumStrategy::processMarketUpdate(const MarketUpdateEvent& event) {
-    std::vector<EventPtr> signals;
-    
-    const Tick& tick = event.getTick();
-    std::int64_t timestamp_us = event.getTimestamp();
+void NewsMomentumStrategy::reset() {
+    Strategy::reset();
+    if (regime_classifier_) regime_classifier_->reset();
+    ema_9_.reset();
+    ema_90_.reset();
+    ema_200_.reset();
+    atr_14_.reset();
+    was_long_ema_above_short_ = false;
+    entry_timestamp_us_ = 0;
+    entry_price_ = 0.0;
+    highest_price_since_entry_ = 0.0;
+    trades_won_ = 0;
+    trades_total_ = 0;
+    avg_win_ = 0.0;
+    avg_loss_ = 0.0;
+}
+
+void NewsMomentumStrategy::onMarketUpdate(const Tick& tick, SignalEmitter& out) {
+    std::int64_t timestamp_us = tick.timestamp_us;
     
     // Update regime classifier
     if (regime_classifier_) {
@@ -29,25 +61,21 @@ std::vector<EventPtr> NewsMomentumStrategy::processMarketUpdate(const MarketUpda
     
     // Update indicators
     indicators_.updatePrice(tick.price);
-    indicators_.updateEMA(tick.price, 9);
-    indicators_.updateEMA(tick.price, 90);
-    indicators_.updateEMA(tick.price, 200);
+    ema_9_.update(tick.price);
+    ema_90_.update(tick.price);
+    ema_200_.update(tick.price);
     indicators_.updateMACD(tick.price);
     indicators_.updateVWAP(tick.price, tick.volume, timestamp_us);
     indicators_.updateVolume(tick.volume, timestamp_us);
-    indicators_.updateATR(tick.price, tick.price, tick.price, 14);
+    atr_14_.update(tick.price, tick.price, tick.price);
     
     // Check exit conditions first if in position
     if (hasPosition()) {
         if (checkExitConditions(tick)) {
-            SignalEvent::Direction direction = (position_ > 0) ? 
-                SignalEvent::Direction::EXIT : SignalEvent::Direction::EXIT;
-            
-            signals.push_back(std::make_unique<SignalEvent>(
-                timestamp_us, symbol_, SignalEvent::Direction::EXIT,
-                std::abs(position_), tick.price));
+            out.emit(timestamp_us, symbol_id_, SignalEvent::Direction::EXIT,
+                     std::abs(position_), tick.price);
         }
-        return signals;
+        return;
     }
     
     // Check entry conditions only if no position
@@ -57,17 +85,14 @@ std::vector<EventPtr> NewsMomentumStrategy::processMarketUpdate(const MarketUpda
         double position_size = calculatePositionSize();
         
         if (position_size > 0.0) {
-            signals.push_back(std::make_unique<SignalEvent>(
-                timestamp_us, symbol_, SignalEvent::Direction::LONG,
-                position_size, tick.price));
+            out.emit(timestamp_us, symbol_id_, SignalEvent::Direction::LONG,
+                     position_size, tick.price);
             
             entry_timestamp_us_ = timestamp_us;
             entry_price_ = tick.price;
             highest_price_since_entry_ = tick.price;
         }
     }
-    
-    return signals;
 }
 
 bool NewsMomentumStrategy::checkEntryConditions(const Tick& tick) {
@@ -181,7 +206,7 @@ double NewsMomentumStrategy::calculatePositionSize() {
 
     // ATR-based volatility scaling: reduce size when ATR% > 3%, increase when < 1%
     double atr_mult = 1.0;
-    double atr_pct  = indicators_.getATRPercent(entry_price_ > 0.0 ? entry_price_ : 100.0, 14);
+    double atr_pct  = atr_14_.percentOf(entry_price_ > 0.0 ? entry_price_ : 100.0);
     if (atr_pct > 0.0) {
         // Inversely proportional: target 2% ATR as baseline
         atr_mult = std::clamp(2.0 / atr_pct, 0.5, 1.5);
@@ -215,19 +240,19 @@ bool NewsMomentumStrategy::checkEMATrend(double price) {
     if (price == 0.0) return false;
     
     // Price must be above both 90-EMA and 200-EMA
-    bool above_90 = indicators_.isPriceAboveEMA(price, 90);
-    bool above_200 = indicators_.isPriceAboveEMA(price, 200);
+    bool above_90 = ema_90_.isPriceAbove(price);
+    bool above_200 = ema_200_.isPriceAbove(price);
     
     // Also check if 90-EMA > 200-EMA (bullish alignment)
-    double ema_90 = indicators_.getEMA(90);
-    double ema_200 = indicators_.getEMA(200);
+    double ema_90 = ema_90_.value();
+    double ema_200 = ema_200_.value();
     
     return above_90 && above_200 && (ema_90 > ema_200);
 }
 
 bool NewsMomentumStrategy::checkEMACrossover() {
-    double ema_9 = indicators_.getEMA(9);
-    double ema_90 = indicators_.getEMA(90);
+    double ema_9 = ema_9_.value();
+    double ema_90 = ema_90_.value();
     
     if (ema_9 == 0.0 || ema_90 == 0.0) return false;
     
@@ -265,10 +290,17 @@ MeanReversionStrategy::MeanReversionStrategy(const std::string& symbol,
                                              RegimeClassifier* regime_classifier)
     : Strategy(symbol), regime_classifier_(regime_classifier) {}
 
-std::vector<EventPtr> MeanReversionStrategy::processMarketUpdate(const MarketUpdateEvent& event) {
-    std::vector<EventPtr> signals;
-    const Tick& tick = event.getTick();
-    std::int64_t timestamp_us = event.getTimestamp();
+void MeanReversionStrategy::reset() {
+    Strategy::reset();
+    if (regime_classifier_) regime_classifier_->reset();
+    ema_20_.reset();
+    entry_price_ = 0.0;
+    prev_price_low_ = 0.0;
+    prev_rsi_low_ = 100.0;
+}
+
+void MeanReversionStrategy::onMarketUpdate(const Tick& tick, SignalEmitter& out) {
+    std::int64_t timestamp_us = tick.timestamp_us;
 
     if (regime_classifier_) {
         regime_classifier_->updateAndClassify(tick);
@@ -277,26 +309,22 @@ std::vector<EventPtr> MeanReversionStrategy::processMarketUpdate(const MarketUpd
     indicators_.updatePrice(tick.price);
     indicators_.updateRSI(tick.price, rsi_period_);
     indicators_.updateBollingerBands(tick.price, bb_period_);
-    indicators_.updateEMA(tick.price, 20);
+    ema_20_.update(tick.price);
     indicators_.updateVolume(tick.volume, timestamp_us);
 
     if (hasPosition()) {
         if (checkExitConditions(tick)) {
-            signals.push_back(std::make_unique<SignalEvent>(
-                timestamp_us, symbol_, SignalEvent::Direction::EXIT,
-                std::abs(position_), tick.price));
+            out.emit(timestamp_us, symbol_id_, SignalEvent::Direction::EXIT,
+                     std::abs(position_), tick.price);
         }
-        return signals;
+        return;
     }
 
     if (checkEntryConditions(tick)) {
-        signals.push_back(std::make_unique<SignalEvent>(
-            timestamp_us, symbol_, SignalEvent::Direction::LONG,
-            base_position_size_, tick.price));
+        out.emit(timestamp_us, symbol_id_, SignalEvent::Direction::LONG,
+                 base_position_size_, tick.price);
         entry_price_ = tick.price;
     }
-
-    return signals;
 }
 
 bool MeanReversionStrategy::checkEntryConditions(const Tick& tick) {
@@ -363,10 +391,17 @@ BreakoutStrategy::BreakoutStrategy(const std::string& symbol,
                                    RegimeClassifier* regime_classifier)
     : Strategy(symbol), regime_classifier_(regime_classifier) {}
 
-std::vector<EventPtr> BreakoutStrategy::processMarketUpdate(const MarketUpdateEvent& event) {
-    std::vector<EventPtr> signals;
-    const Tick& tick = event.getTick();
-    std::int64_t timestamp_us = event.getTimestamp();
+void BreakoutStrategy::reset() {
+    Strategy::reset();
+    if (regime_classifier_) regime_classifier_->reset();
+    ema_20_.reset();
+    entry_price_ = 0.0;
+    highest_since_entry_ = 0.0;
+    is_long_ = true;
+}
+
+void BreakoutStrategy::onMarketUpdate(const Tick& tick, SignalEmitter& out) {
+    std::int64_t timestamp_us = tick.timestamp_us;
 
     if (regime_classifier_) regime_classifier_->updateAndClassify(tick);
 
@@ -375,28 +410,24 @@ std::vector<EventPtr> BreakoutStrategy::processMarketUpdate(const MarketUpdateEv
     indicators_.updateCCI(tick.price, tick.price, tick.price, cci_period_);
     indicators_.updateVolume(tick.volume, timestamp_us);
     indicators_.updateOBV(tick.price, tick.volume);
-    indicators_.updateEMA(tick.price, 20);
+    ema_20_.update(tick.price);
     indicators_.updateVWAP(tick.price, tick.volume, timestamp_us);
 
     if (hasPosition()) {
         if (checkExitConditions(tick)) {
-            signals.push_back(std::make_unique<SignalEvent>(
-                timestamp_us, symbol_, SignalEvent::Direction::EXIT,
-                std::abs(position_), tick.price));
+            out.emit(timestamp_us, symbol_id_, SignalEvent::Direction::EXIT,
+                     std::abs(position_), tick.price);
         }
-        return signals;
+        return;
     }
 
     if (checkLongEntry(tick)) {
-        signals.push_back(std::make_unique<SignalEvent>(
-            timestamp_us, symbol_, SignalEvent::Direction::LONG,
-            base_position_size_, tick.price));
+        out.emit(timestamp_us, symbol_id_, SignalEvent::Direction::LONG,
+                 base_position_size_, tick.price);
         entry_price_ = tick.price;
         highest_since_entry_ = tick.price;
         is_long_ = true;
     }
-
-    return signals;
 }
 
 bool BreakoutStrategy::checkLongEntry(const Tick& tick) {
@@ -456,4 +487,35 @@ bool BreakoutStrategy::checkExitConditions(const Tick& tick) {
     return false;
 }
 
+// ── Factory ──────────────────────────────────────────────────────────────────
+std::unique_ptr<Strategy> makeStrategy(const std::string& name, const std::string& symbol,
+                                       RegimeClassifier* regime_classifier,
+                                       const StrategyParams& params) {
+    if (name == "breakout") {
+        auto s = std::make_unique<BreakoutStrategy>(symbol, regime_classifier);
+        s->setBasePositionSize(params.base_position_size);
+        s->setStopLossPercent(params.stop_loss_pct);
+        s->setTakeProfitPercent(params.take_profit_pct);
+        s->setTrailingStopPercent(params.trailing_stop_pct);
+        if (params.min_relative_volume > 0.0) s->setMinRelativeVolume(params.min_relative_volume);
+        return s;
+    }
+    if (name == "meanrev") {
+        auto s = std::make_unique<MeanReversionStrategy>(symbol, regime_classifier);
+        s->setBasePositionSize(params.base_position_size);
+        s->setStopLossPercent(params.stop_loss_pct);
+        s->setTakeProfitPercent(params.take_profit_pct);
+        return s;
+    }
+    auto s = std::make_unique<NewsMomentumStrategy>(symbol, regime_classifier);
+    s->setMinRelativeVolume(params.min_relative_volume > 0.0 ? params.min_relative_volume : 5.0);
+    s->setMinGapUpPercent(10.0);
+    s->setMinBidAskRatio(1.5);
+    s->setBasePositionSize(params.base_position_size);
+    s->setStopLossPercent(params.stop_loss_pct);
+    s->setTakeProfitPercent(params.take_profit_pct);
+    s->setTrailingStopPercent(params.trailing_stop_pct);
+    return s;
+}
+
 } // namespace AlgoCatalyst
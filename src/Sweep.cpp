@@ -0,0 +1,193 @@
+#include "Sweep.h"
+#include "AI_Regime.h"
+#include "Engine.h"
+#include "PerformanceAnalyzer.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace AlgoCatalyst {
+
+ParameterSweep::ParameterSweep(std::string strategy_name, double latency_ms)
+    : strategy_name_(std::move(strategy_name)), latency_ms_(latency_ms) {
+}
+
+bool ParameterSweep::loadTickData(const std::string& path, const std::string& symbol, const TickFilter& filter) {
+    TickInput data = TickInput::open(path, symbol, filter);
+    if (!data) return false;
+    inputs_.push_back({symbol, std::move(data), filter});
+    return true;
+}
+
+void ParameterSweep::addSeries(const std::string& symbol, TickSeriesPtr ticks) {
+    inputs_.push_back({symbol, {nullptr, nullptr, std::move(ticks)}, {}});
+}
+
+void ParameterSweep::addTickFile(const std::string& symbol, TickFilePtr file, const TickFilter& filter) {
+    inputs_.push_back({symbol, {std::move(file), nullptr, nullptr}, filter});
+}
+
+void ParameterSweep::addCompressedTickFile(const std::string& symbol, CompressedTickFilePtr file,
+                                           const TickFilter& filter) {
+    inputs_.push_back({symbol, {nullptr, std::move(file), nullptr}, filter});
+}
+
+std::vector<SweepCombo> ParameterSweep::combinations() const {
+    std::vector<SweepCombo> combos;
+    combos.reserve(grid_.size());
+    for (double sl : grid_.stop_loss_pct) {
+        for (double tp : grid_.take_profit_pct) {
+            if (grid_.require_tp_above_sl && tp <= sl) continue;
+            for (double trail : grid_.trailing_stop_pct) {
+                for (double rel_vol : grid_.min_relative_volume) {
+                    for (double slip : grid_.slippage_bps) {
+                        SweepCombo combo;
+                        combo.params.stop_loss_pct = sl;
+                        combo.params.take_profit_pct = tp;
+                        combo.params.trailing_stop_pct = trail;
+                        combo.params.min_relative_volume = rel_vol;
+                        combo.slippage_bps = slip;
+                        combos.push_back(combo);
+                    }
+                }
+            }
+        }
+    }
+    return combos;
+}
+
+std::vector<SweepResult> ParameterSweep::run(
+        const std::function<void(std::size_t, std::size_t)>& progress) const {
+    const std::vector<SweepCombo> combos = combinations();
+    std::vector<SweepResult> results(combos.size());
+    if (combos.empty() || inputs_.empty()) return results;
+
+    unsigned n = threads_ ? threads_ : std::max(1u, std::thread::hardware_concurrency());
+    n = static_cast<unsigned>(std::min<std::size_t>(n, combos.size()));
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::vector<std::exception_ptr> errors(n);
+
+    auto worker = [&](unsigned w) {
+        try {
+            // One engine and one classifier per symbol, reused for every combination
+            Backtester bt(latency_ms_);
+            bt.setVerbose(false);
+            std::vector<std::unique_ptr<RegimeClassifier>> classifiers;
+            for (const auto& input : inputs_) {
+                if (!bt.addTickInput(input.symbol, input.data, input.filter)) {
+                    throw std::runtime_error("symbol " + input.symbol + " not in tick file");
+                }
+                classifiers.push_back(std::make_unique<RegimeClassifier>(100, 2));
+            }
+
+            for (std::size_t i = next++; i < combos.size(); i = next++) {
+                const SweepCombo& combo = combos[i];
+                bt.reset();
+                bt.setSlippageBps(combo.slippage_bps);
+                for (std::size_t k = 0; k < inputs_.size(); ++k) {
+                    const std::string& symbol = inputs_[k].symbol;
+                    classifiers[k]->reset();
+                    bt.registerStrategy(symbol, makeStrategy(strategy_name_, symbol, classifiers[k].get(), combo.params));
+                }
+                bt.run();
+
+                auto m = PerformanceAnalyzer::compute(bt.getTradeLog());
+                SweepResult& r = results[i];
+                r.combo = combo;
+                r.num_trades = m.num_trades;
+                r.total_pnl = m.total_pnl;
+                r.win_rate = m.win_rate;
+                r.profit_factor = m.profit_factor;
+                r.sharpe_ratio = m.sharpe_ratio;
+                r.max_drawdown = m.max_drawdown;
+
+                std::size_t finished = ++done;
+                if (progress) progress(finished, combos.size());
+            }
+        } catch (...) {
+            errors[w] = std::current_exception();
+            next = combos.size();   // Stop the other workers early
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(n);
+    for (unsigned w = 0; w < n; ++w) {
+        workers.emplace_back(worker, w);
+    }
+    for (auto& t : workers) {
+        t.join();
+    }
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    return results;
+}
+
+bool ParameterSweep::sortByMetric(std::vector<SweepResult>& results, const std::string& metric) {
+    double SweepResult::* field = nullptr;
+    if (metric == "sharpe")             field = &SweepResult::sharpe_ratio;
+    else if (metric == "pnl")           field = &SweepResult::total_pnl;
+    else if (metric == "profit_factor") field = &SweepResult::profit_factor;
+    else if (metric == "win_rate")      field = &SweepResult::win_rate;
+    else return false;
+
+    std::stable_sort(results.begin(), results.end(),
+                     [field](const SweepResult& a, const SweepResult& b) { return a.*field > b.*field; });
+    return true;
+}
+
+bool ParameterSweep::writeCSV(const std::vector<SweepResult>& results, const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file for writing: " << path << std::endl;
+        return false;
+    }
+
+    file << "stop_loss,take_profit,trailing,min_rel_volume,slippage,"
+            "num_trades,pnl,win_rate,profit_factor,sharpe,max_dd\n";
+    file << std::setprecision(10);
+    for (const auto& r : results) {
+        const StrategyParams& p = r.combo.params;
+        file << p.stop_loss_pct << "," << p.take_profit_pct << "," << p.trailing_stop_pct << ","
+             << p.min_relative_volume << "," << r.combo.slippage_bps << ","
+             << r.num_trades << "," << r.total_pnl << "," << r.win_rate << ","
+             << r.profit_factor << "," << r.sharpe_ratio << "," << r.max_drawdown << "\n";
+    }
+    return true;
+}
+
+void ParameterSweep::printTable(const std::vector<SweepResult>& results, std::size_t max_rows,
+                                std::ostream& out) {
+    out << std::right << std::setw(6) << "SL" << std::setw(7) << "TP" << std::setw(7) << "Trail"
+        << std::setw(7) << "RelVol" << std::setw(6) << "Slip" << " | "
+        << std::setw(8) << "Sharpe" << std::setw(12) << "PnL" << std::setw(8) << "PF"
+        << std::setw(8) << "WR%" << std::setw(7) << "Trades" << "\n";
+    out << std::string(82, '-') << "\n";
+
+    out << std::fixed;
+    std::size_t rows = std::min(max_rows, results.size());
+    for (std::size_t i = 0; i < rows; ++i) {
+        const auto& r = results[i];
+        const StrategyParams& p = r.combo.params;
+        out << std::setprecision(1)
+            << std::setw(6) << p.stop_loss_pct << std::setw(7) << p.take_profit_pct
+            << std::setw(7) << p.trailing_stop_pct << std::setw(7) << p.min_relative_volume
+            << std::setw(6) << r.combo.slippage_bps << " | "
+            << std::setprecision(3) << std::setw(8) << r.sharpe_ratio
+            << std::setprecision(2) << std::setw(12) << r.total_pnl
+            << std::setw(8) << r.profit_factor
+            << std::setprecision(1) << std::setw(8) << r.win_rate
+            << std::setw(7) << r.num_trades << "\n";
+    }
+    out.unsetf(std::ios::fixed);
+}
+
+} // namespace AlgoCatalyst
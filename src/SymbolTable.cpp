@@ -0,0 +1,43 @@
+#include "SymbolTable.h"
+#include <stdexcept>
+
+namespace AlgoCatalyst {
+
+SymbolTable& SymbolTable::global() {
+    static SymbolTable table;
+    return table;
+}
+
+SymbolId SymbolTable::intern(std::string_view ticker) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(ticker);
+    if (it != ids_.end()) return it->second;
+
+    SymbolId id = static_cast<SymbolId>(names_.size());
+    names_.emplace_back(ticker);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+bool SymbolTable::find(std::string_view ticker, SymbolId& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(ticker);
+    if (it == ids_.end()) return false;
+    id = it->second;
+    return true;
+}
+
+const std::string& SymbolTable::name(SymbolId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= names_.size()) {
+        throw std::out_of_range("Unknown SymbolId " + std::to_string(id));
+    }
+    return names_[id];
+}
+
+std::size_t SymbolTable::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.size();
+}
+
+} // namespace AlgoCatalyst
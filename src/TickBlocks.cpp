@@ -0,0 +1,582 @@
+#include "TickBlocks.h"
+#include "TickFile.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace AlgoCatalyst {
+
+static_assert(std::endian::native == std::endian::little, "tick files are little-endian");
+
+namespace {
+
+// Per-column encoding tag, first byte of each column in a block
+enum Encoding : std::uint8_t {
+    kRaw = 0,           // rows x 8 bytes as stored in memory
+    kDelta = 1,         // zigzag varint of v[0], then of each v[i] - v[i-1]
+    kScaledDelta = 2,   // u8 decimals d, then kDelta of round(v * 10^d)
+    kBitPack = 3,       // zigzag varint min, u8 width, then (v - min) in 'width' bits each
+    kSameAsPrice = 4,   // high/low equal to price on every row; nothing stored
+};
+
+constexpr int kMaxDecimals = 9;
+constexpr double kPow10[kMaxDecimals + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+constexpr double kMaxExactInteger = 9007199254740992.0;   // 2^53
+constexpr unsigned kMaxPackWidth = 56;
+
+std::uint64_t zigzag(std::int64_t v) {
+    return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t v) {
+    return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+// Two's-complement difference; wraps instead of overflowing
+std::int64_t wrappingSub(std::int64_t a, std::int64_t b) {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) - static_cast<std::uint64_t>(b));
+}
+
+std::int64_t wrappingAdd(std::int64_t a, std::int64_t b) {
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(a) + static_cast<std::uint64_t>(b));
+}
+
+// ── Encoding ─────────────────────────────────────────────────────────────────
+
+void putVarint(std::vector<std::uint8_t>& out, std::uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(v));
+}
+
+void putRaw(std::vector<std::uint8_t>& out, const void* data, std::size_t bytes) {
+    const auto* p = static_cast<const std::uint8_t*>(data);
+    out.insert(out.end(), p, p + bytes);
+}
+
+void putDeltas(std::vector<std::uint8_t>& out, const std::vector<std::int64_t>& values) {
+    std::int64_t prev = 0;
+    for (std::int64_t v : values) {
+        putVarint(out, zigzag(wrappingSub(v, prev)));
+        prev = v;
+    }
+}
+
+void putBitPacked(std::vector<std::uint8_t>& out, const std::vector<std::int64_t>& values,
+                  std::int64_t min, unsigned width) {
+    putVarint(out, zigzag(min));
+    out.push_back(static_cast<std::uint8_t>(width));
+    std::uint64_t acc = 0;
+    unsigned bits = 0;
+    for (std::int64_t v : values) {
+        acc |= static_cast<std::uint64_t>(wrappingSub(v, min)) << bits;
+        bits += width;
+        while (bits >= 8) {
+            out.push_back(static_cast<std::uint8_t>(acc));
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0) out.push_back(static_cast<std::uint8_t>(acc));
+}
+
+// Bit width of max - min, or a value above kMaxPackWidth if the range is too wide to pack
+unsigned packWidth(const std::vector<std::int64_t>& values, std::int64_t& min) {
+    auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+    min = *lo;
+    return static_cast<unsigned>(std::bit_width(static_cast<std::uint64_t>(*hi) - static_cast<std::uint64_t>(*lo)));
+}
+
+// Smallest decimal scale at which every value round-trips bit-exactly through
+// an integer (decoded as integer / 10^d), or -1 if none does
+int findScale(const std::vector<double>& values, std::vector<std::int64_t>& scaled) {
+    scaled.resize(values.size());
+    for (int d = 0; d <= kMaxDecimals; ++d) {
+        bool exact = true;
+        for (std::size_t i = 0; i < values.size() && exact; ++i) {
+            double s = values[i] * kPow10[d];
+            if (!(std::fabs(s) < kMaxExactInteger)) return -1;
+            std::int64_t q = std::llround(s);
+            double decoded = static_cast<double>(q) / kPow10[d];
+            exact = std::memcmp(&decoded, &values[i], sizeof(double)) == 0;
+            scaled[i] = q;
+        }
+        if (exact) return d;
+    }
+    return -1;
+}
+
+// Doubles that are all integers representable exactly
+bool asIntegers(const std::vector<double>& values, std::vector<std::int64_t>& ints) {
+    ints.resize(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (!(std::fabs(values[i]) < kMaxExactInteger)) return false;
+        ints[i] = static_cast<std::int64_t>(values[i]);
+        double decoded = static_cast<double>(ints[i]);
+        if (std::memcmp(&decoded, &values[i], sizeof(double)) != 0) return false;
+    }
+    return true;
+}
+
+void encodeRaw(std::vector<std::uint8_t>& out, const std::vector<double>& values) {
+    out.push_back(kRaw);
+    putRaw(out, values.data(), values.size() * sizeof(double));
+}
+
+void encodeDecimal(std::vector<std::uint8_t>& out, const std::vector<double>& values,
+                   std::vector<std::int64_t>& scratch) {
+    int d = findScale(values, scratch);
+    if (d < 0) {
+        encodeRaw(out, values);
+        return;
+    }
+    out.push_back(kScaledDelta);
+    out.push_back(static_cast<std::uint8_t>(d));
+    putDeltas(out, scratch);
+}
+
+void encodeSize(std::vector<std::uint8_t>& out, const std::vector<double>& values,
+                std::vector<std::int64_t>& scratch) {
+    std::int64_t min = 0;
+    if (asIntegers(values, scratch)) {
+        unsigned width = packWidth(scratch, min);
+        if (width <= kMaxPackWidth) {
+            out.push_back(kBitPack);
+            putBitPacked(out, scratch, min, width);
+            return;
+        }
+    }
+    encodeDecimal(out, values, scratch);
+}
+
+void encodeHighLow(std::vector<std::uint8_t>& out, const std::vector<double>& values,
+                   const std::vector<double>& prices, std::vector<std::int64_t>& scratch) {
+    if (std::equal(values.begin(), values.end(), prices.begin(),
+                    [](double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; })) {
+        out.push_back(kSameAsPrice);
+        return;
+    }
+    encodeDecimal(out, values, scratch);
+}
+
+void encodeBlock(std::span<const Tick> ticks, std::vector<std::uint8_t>& out) {
+    const std::size_t n = ticks.size();
+    std::vector<std::int64_t> ints(n), scratch;
+    std::vector<double> prices(n), values(n);
+
+    // timestamp
+    for (std::size_t i = 0; i < n; ++i) ints[i] = ticks[i].timestamp_us;
+    out.push_back(kDelta);
+    putDeltas(out, ints);
+
+    // price
+    for (std::size_t i = 0; i < n; ++i) prices[i] = ticks[i].price;
+    encodeDecimal(out, prices, scratch);
+
+    // volume
+    for (std::size_t i = 0; i < n; ++i) ints[i] = ticks[i].volume;
+    std::int64_t min = 0;
+    unsigned width = packWidth(ints, min);
+    if (width <= kMaxPackWidth) {
+        out.push_back(kBitPack);
+        putBitPacked(out, ints, min, width);
+    } else {
+        out.push_back(kDelta);
+        putDeltas(out, ints);
+    }
+
+    // bid_size, ask_size
+    for (std::size_t i = 0; i < n; ++i) values[i] = ticks[i].bid_size;
+    encodeSize(out, values, scratch);
+    for (std::size_t i = 0; i < n; ++i) values[i] = ticks[i].ask_size;
+    encodeSize(out, values, scratch);
+
+    // high, low
+    for (std::size_t i = 0; i < n; ++i) values[i] = ticks[i].high;
+    encodeHighLow(out, values, prices, scratch);
+    for (std::size_t i = 0; i < n; ++i) values[i] = ticks[i].low;
+    encodeHighLow(out, values, prices, scratch);
+}
+
+// ── Decoding ─────────────────────────────────────────────────────────────────
+
+// Bounds-checked cursor over one block; any overrun clears 'ok'
+struct BlockReader {
+    const std::uint8_t* p;
+    const std::uint8_t* end;
+    bool ok = true;
+
+    std::uint8_t byte() {
+        if (p >= end) { ok = false; return 0; }
+        return *p++;
+    }
+
+    std::uint64_t varint() {
+        std::uint64_t v = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (p >= end) { ok = false; return 0; }
+            std::uint8_t b = *p++;
+            v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        ok = false;
+        return 0;
+    }
+};
+
+// Decode an integer-valued column (kDelta / kBitPack) into 'store(i, value)'
+template <typename Store>
+bool decodeIntegers(BlockReader& in, std::uint8_t encoding, std::size_t n, Store store) {
+    if (encoding == kDelta) {
+        std::int64_t v = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            v = wrappingAdd(v, unzigzag(in.varint()));
+            store(i, v);
+        }
+        return in.ok;
+    }
+    if (encoding == kBitPack) {
+        std::int64_t min = unzigzag(in.varint());
+        unsigned width = in.byte();
+        if (!in.ok || width > kMaxPackWidth) return false;
+        std::size_t bytes = (n * width + 7) / 8;
+        if (static_cast<std::size_t>(in.end - in.p) < bytes) return false;
+        const std::uint64_t mask = width ? (~std::uint64_t{0} >> (64 - width)) : 0;
+        const std::uint8_t* p = in.p;
+        std::uint64_t acc = 0;
+        unsigned bits = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            while (bits < width) {
+                acc |= static_cast<std::uint64_t>(*p++) << bits;
+                bits += 8;
+            }
+            store(i, wrappingAdd(min, static_cast<std::int64_t>(acc & mask)));
+            acc >>= width;
+            bits -= width;
+        }
+        in.p += bytes;
+        return true;
+    }
+    return false;
+}
+
+// Decode a double column into the Tick field 'field'
+bool decodeDoubles(BlockReader& in, std::vector<Tick>& out, double Tick::* field) {
+    const std::size_t n = out.size();
+    std::uint8_t encoding = in.byte();
+    switch (encoding) {
+    case kRaw:
+        if (static_cast<std::size_t>(in.end - in.p) < n * sizeof(double)) return false;
+        for (std::size_t i = 0; i < n; ++i) {
+            std::memcpy(&(out[i].*field), in.p + i * sizeof(double), sizeof(double));
+        }
+        in.p += n * sizeof(double);
+        return true;
+    case kScaledDelta: {
+        unsigned d = in.byte();
+        if (!in.ok || d > static_cast<unsigned>(kMaxDecimals)) return false;
+        const double scale = kPow10[d];
+        return decodeIntegers(in, kDelta, n, [&](std::size_t i, std::int64_t v) {
+            out[i].*field = static_cast<double>(v) / scale;
+        });
+    }
+    case kBitPack:
+        return decodeIntegers(in, kBitPack, n, [&](std::size_t i, std::int64_t v) {
+            out[i].*field = static_cast<double>(v);
+        });
+    case kSameAsPrice:
+        for (auto& tick : out) tick.*field = tick.price;
+        return true;
+    default:
+        return false;
+    }
+}
+
+template <typename T>
+void writeValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+} // namespace
+
+// ── CompressedTickFile ───────────────────────────────────────────────────────
+
+std::shared_ptr<const CompressedTickFile> CompressedTickFile::open(const std::string& path) {
+    auto fail = [&path](const char* reason) {
+        std::cerr << "Error: " << path << ": " << reason << std::endl;
+        return nullptr;
+    };
+
+    std::shared_ptr<CompressedTickFile> tf(new CompressedTickFile());
+    if (!tf->file_.open(path)) return fail("cannot open file");
+    tf->path_ = path;
+
+    const std::size_t size = tf->file_.size();
+    const char* data = tf->file_.data();
+    TickBlockHeader header;
+    if (size < sizeof(header)) return fail("not a block tick file (too short)");
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, TickBlockHeader::kMagic, sizeof(header.magic)) != 0) {
+        return fail("not a block tick file (bad magic)");
+    }
+    if (header.version != TickBlockHeader::kVersion) return fail("unsupported block tick file version");
+    if (header.header_size < sizeof(header) || header.header_size > size) return fail("corrupt header");
+
+    // Block index: 8-byte aligned, inside the file, every block inside the file
+    const std::uint64_t index_bytes = std::uint64_t{header.block_count} * sizeof(TickBlockInfo);
+    if (header.block_index_offset % 8 != 0 || header.block_index_offset > size ||
+        size - header.block_index_offset < index_bytes) {
+        return fail("corrupt block index");
+    }
+    tf->blocks_ = reinterpret_cast<const TickBlockInfo*>(data + header.block_index_offset);
+    tf->block_count_ = header.block_count;
+    for (const TickBlockInfo& block : tf->blocks()) {
+        if (block.offset > size || size - block.offset < block.size || block.rows > header.block_rows) {
+            return fail("corrupt block index");
+        }
+    }
+
+    // Symbol table: {first_row u64, row_count u64, first_block u32, block_count u32, name_length u32, name}
+    if (header.symbol_table_offset > size || size - header.symbol_table_offset < header.symbol_table_size) {
+        return fail("corrupt symbol table");
+    }
+    const char* p = data + header.symbol_table_offset;
+    const char* const table_end = p + header.symbol_table_size;
+    for (std::uint32_t s = 0; s < header.symbol_count; ++s) {
+        SymbolRange range;
+        std::uint32_t name_length = 0;
+        if (table_end - p < 28) return fail("corrupt symbol table");
+        std::memcpy(&range.first_row, p, 8);
+        std::memcpy(&range.row_count, p + 8, 8);
+        std::memcpy(&range.first_block, p + 16, 4);
+        std::memcpy(&range.block_count, p + 20, 4);
+        std::memcpy(&name_length, p + 24, 4);
+        p += 28;
+        if (static_cast<std::uint64_t>(table_end - p) < name_length) return fail("corrupt symbol table");
+        range.name.assign(p, name_length);
+        p += name_length;
+        p += (8 - (static_cast<std::uint64_t>(p - data) % 8)) % 8;
+
+        if (range.first_block > header.block_count || header.block_count - range.first_block < range.block_count) {
+            return fail("symbol blocks out of range");
+        }
+        std::uint64_t rows = 0;
+        for (std::uint32_t b = 0; b < range.block_count; ++b) rows += tf->blocks_[range.first_block + b].rows;
+        if (rows != range.row_count) return fail("symbol row count does not match its blocks");
+        tf->symbols_.push_back(std::move(range));
+    }
+
+    tf->rows_ = header.row_count;
+    return tf;
+}
+
+bool CompressedTickFile::isCompressedFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(TickBlockHeader::kMagic)] = {};
+    in.read(magic, sizeof(magic));
+    return in.gcount() == sizeof(magic) && std::memcmp(magic, TickBlockHeader::kMagic, sizeof(magic)) == 0;
+}
+
+const CompressedTickFile::SymbolRange* CompressedTickFile::findSymbol(std::string_view name) const {
+    for (const auto& range : symbols_) {
+        if (range.name == name) return &range;
+    }
+    return nullptr;
+}
+
+std::uint32_t CompressedTickFile::findBlock(const SymbolRange& range, std::int64_t ts) const {
+    const TickBlockInfo* first = blocks_ + range.first_block;
+    const TickBlockInfo* last = first + range.block_count;
+    const TickBlockInfo* it = std::partition_point(first, last,
+        [ts](const TickBlockInfo& block) { return block.max_timestamp_us < ts; });
+    return static_cast<std::uint32_t>(it - blocks_);
+}
+
+bool CompressedTickFile::decodeBlock(std::uint32_t index, SymbolId symbol, std::vector<Tick>& out) const {
+    const TickBlockInfo& block = blocks_[index];
+    const auto* base = reinterpret_cast<const std::uint8_t*>(file_.data());
+    BlockReader in{base + block.offset, base + block.offset + block.size};
+    const std::size_t n = block.rows;
+
+    out.resize(n);
+    for (auto& tick : out) {
+        tick.symbol_id = symbol;
+    }
+
+    bool ok = in.byte() == kDelta &&
+        decodeIntegers(in, kDelta, n, [&](std::size_t i, std::int64_t v) { out[i].timestamp_us = v; });
+    ok = ok && decodeDoubles(in, out, &Tick::price);
+    if (ok) {
+        std::uint8_t encoding = in.byte();
+        ok = decodeIntegers(in, encoding, n, [&](std::size_t i, std::int64_t v) { out[i].volume = v; });
+    }
+    ok = ok && decodeDoubles(in, out, &Tick::bid_size);
+    ok = ok && decodeDoubles(in, out, &Tick::ask_size);
+    ok = ok && decodeDoubles(in, out, &Tick::high);
+    ok = ok && decodeDoubles(in, out, &Tick::low);
+
+    if (!ok || !in.ok) {
+        std::cerr << "Error: " << path_ << ": corrupt block " << index << std::endl;
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+bool CompressedTickFile::write(const std::string& path,
+                               const std::vector<std::pair<std::string, std::span<const Tick>>>& series,
+                               std::uint32_t block_rows) {
+    if (!allSortedByTimestamp(path, series)) return false;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << path << std::endl;
+        return false;
+    }
+    if (block_rows == 0) block_rows = TickBlockHeader::kDefaultBlockRows;
+
+    TickBlockHeader header{};
+    std::memcpy(header.magic, TickBlockHeader::kMagic, sizeof(header.magic));
+    header.version = TickBlockHeader::kVersion;
+    header.header_size = sizeof(TickBlockHeader);
+    header.block_rows = block_rows;
+    header.symbol_count = static_cast<std::uint32_t>(series.size());
+    for (const auto& [name, ticks] : series) {
+        header.row_count += ticks.size();
+        header.block_count += static_cast<std::uint32_t>((ticks.size() + block_rows - 1) / block_rows);
+        header.symbol_table_size += (28 + name.size() + 7) / 8 * 8;
+    }
+
+    // Layout: header | symbol table | block index | blocks
+    header.symbol_table_offset = sizeof(TickBlockHeader);
+    header.block_index_offset = header.symbol_table_offset + header.symbol_table_size;
+    writeValue(out, header);
+
+    std::uint64_t first_row = 0;
+    std::uint32_t first_block = 0;
+    for (const auto& [name, ticks] : series) {
+        auto blocks = static_cast<std::uint32_t>((ticks.size() + block_rows - 1) / block_rows);
+        writeValue(out, first_row);
+        writeValue(out, static_cast<std::uint64_t>(ticks.size()));
+        writeValue(out, first_block);
+        writeValue(out, blocks);
+        writeValue(out, static_cast<std::uint32_t>(name.size()));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+        static const char zeros[8] = {};
+        out.write(zeros, static_cast<std::streamsize>((8 - (28 + name.size()) % 8) % 8));
+        first_row += ticks.size();
+        first_block += blocks;
+    }
+
+    // Blocks follow the index; the index is written once their offsets are known
+    std::vector<TickBlockInfo> index;
+    index.reserve(header.block_count);
+    std::uint64_t offset = header.block_index_offset + std::uint64_t{header.block_count} * sizeof(TickBlockInfo);
+    out.seekp(static_cast<std::streamoff>(offset));
+
+    std::vector<std::uint8_t> payload;
+    for (const auto& entry : series) {
+        std::span<const Tick> ticks = entry.second;
+        for (std::size_t begin = 0; begin < ticks.size(); begin += block_rows) {
+            auto block = ticks.subspan(begin, std::min<std::size_t>(block_rows, ticks.size() - begin));
+            payload.clear();
+            encodeBlock(block, payload);
+
+            TickBlockInfo info{};
+            info.offset = offset;
+            info.size = static_cast<std::uint32_t>(payload.size());
+            info.rows = static_cast<std::uint32_t>(block.size());
+            auto [lo, hi] = std::minmax_element(block.begin(), block.end(),
+                [](const Tick& a, const Tick& b) { return a.timestamp_us < b.timestamp_us; });
+            info.min_timestamp_us = lo->timestamp_us;
+            info.max_timestamp_us = hi->timestamp_us;
+            index.push_back(info);
+
+            out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+            offset += payload.size();
+        }
+    }
+
+    out.seekp(static_cast<std::streamoff>(header.block_index_offset));
+    out.write(reinterpret_cast<const char*>(index.data()),
+              static_cast<std::streamsize>(index.size() * sizeof(TickBlockInfo)));
+
+    out.flush();
+    if (!out) {
+        std::cerr << "Error: Failed writing " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ── CompressedTickSource ─────────────────────────────────────────────────────
+
+bool CompressedTickSource::loadNextBlock() {
+    const std::uint32_t end = range_.first_block + range_.block_count;
+    auto blocks = file_->blocks();
+    pos_ = 0;
+    buffer_.clear();
+    while (next_block_ < end) {
+        const TickBlockInfo& info = blocks[next_block_];
+        if (info.min_timestamp_us >= filter_.end_us) break;
+        if (filter_.nextInside(info.min_timestamp_us) > info.max_timestamp_us) {
+            ++next_block_;   // Nothing in this block passes
+            continue;
+        }
+        if (!decode(next_block_, buffer_)) break;   // Stop the stream at a corrupt block
+        ++next_block_;
+        return true;
+    }
+    next_block_ = end;
+    return false;
+}
+
+bool CompressedTickSource::decode(std::uint32_t index, std::vector<Tick>& out) const {
+    if (!file_->decodeBlock(index, symbol_, out)) return false;
+    if (!filter_.passesAll()) {
+        const TickFilter& filter = filter_;
+        out.erase(std::remove_if(out.begin(), out.end(), [&filter](const Tick& t) { return !filter.contains(t.timestamp_us); }),
+                  out.end());
+    }
+    return true;
+}
+
+void CompressedTickSource::seek(std::int64_t ts) {
+    next_block_ = file_->findBlock(range_, ts);
+    buffer_.clear();
+    pos_ = 0;
+    if (!loadNextBlock()) return;
+    while (pos_ < buffer_.size() && buffer_[pos_].timestamp_us < ts) ++pos_;
+}
+
+const Tick* CompressedTickSource::firstAtOrAfter(std::int64_t ts) {
+    auto before = [](const Tick& tick, std::int64_t t) { return tick.timestamp_us < t; };
+    if (buffer_.empty()) return peek();
+    auto it = std::lower_bound(buffer_.begin(), buffer_.end(), ts, before);
+    if (it == buffer_.end()) return peek();
+    if (it != buffer_.begin()) return &*it;
+
+    // The answer may sit in an earlier block: the stream has already moved on
+    // to this one, or a run of equal timestamps straddles the boundary
+    const Tick* found = &*it;
+    auto blocks = file_->blocks();
+    for (std::uint32_t b = next_block_ - 1; b > range_.first_block && blocks[b - 1].max_timestamp_us >= ts; --b) {
+        if (!decode(b - 1, lookback_)) return nullptr;
+        auto back = std::lower_bound(lookback_.begin(), lookback_.end(), ts, before);
+        if (back == lookback_.end()) {
+            if (lookback_.empty()) continue;   // Filtered out entirely
+            break;
+        }
+        found_ = *back;
+        found = &found_;
+        if (back != lookback_.begin()) break;
+    }
+    return found;
+}
+
+} // namespace AlgoCatalyst
@@ -0,0 +1,120 @@
+#include "TickCache.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace AlgoCatalyst {
+
+static_assert(std::endian::native == std::endian::little, "tick caches are little-endian");
+
+bool TickCacheKey::of(const std::string& path, std::string_view contents, TickCacheKey& out) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) return false;
+    std::error_code ec;
+    std::filesystem::path absolute = std::filesystem::absolute(path, ec);
+    out.size = static_cast<std::uint64_t>(st.st_size);
+    out.mtime_ns = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000LL + st.st_mtim.tv_nsec;
+    out.hash = TickCache::hashContents(contents);
+    out.path = ec ? path : absolute.lexically_normal().string();
+    return true;
+}
+
+std::uint64_t TickCache::hashContents(std::string_view contents) {
+    // Multiply-xorshift over 8-byte words, then the tail bytes
+    constexpr std::uint64_t kMul = 0x9E3779B97F4A7C15ULL;
+    std::uint64_t h = contents.size() * kMul;
+    const char* p = contents.data();
+    std::size_t n = contents.size();
+    for (; n >= 8; p += 8, n -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p, 8);
+        h = (h ^ word) * kMul;
+        h ^= h >> 29;
+    }
+    for (; n > 0; ++p, --n) {
+        h = (h ^ static_cast<unsigned char>(*p)) * kMul;
+        h ^= h >> 29;
+    }
+    return h;
+}
+
+bool TickCache::read(const std::string& path, const TickCacheKey& key, const TickFilter& filter,
+                     std::vector<Tick>& ticks, std::size_t& skipped_rows) {
+    MappedFile file(path);
+    if (!file.is_open() || file.size() < sizeof(TickCacheHeader)) return false;
+
+    TickCacheHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, TickCacheHeader::kMagic, sizeof(header.magic)) != 0 ||
+        header.version != TickCacheHeader::kVersion || header.tick_size != sizeof(Tick) ||
+        header.source_size != key.size || header.source_mtime_ns != key.mtime_ns ||
+        header.source_hash != key.hash || header.path_size != key.path.size() ||
+        file.size() - sizeof(header) < header.path_size ||
+        std::memcmp(file.data() + sizeof(header), key.path.data(), key.path.size()) != 0) {
+        return false;
+    }
+    if (header.tick_offset % alignof(Tick) != 0 || header.tick_offset > file.size() ||
+        (file.size() - header.tick_offset) / sizeof(Tick) != header.tick_count) {
+        return false;
+    }
+
+    const Tick* begin = reinterpret_cast<const Tick*>(file.data() + header.tick_offset);
+    const Tick* end = begin + header.tick_count;
+    ticks.clear();
+    if (filter.passesAll()) {
+        ticks.assign(begin, end);
+    } else {
+        std::copy_if(begin, end, std::back_inserter(ticks),
+                     [&filter](const Tick& t) { return filter.contains(t.timestamp_us); });
+    }
+    skipped_rows = static_cast<std::size_t>(header.skipped_rows);
+    return true;
+}
+
+bool TickCache::write(const std::string& path, const TickCacheKey& key, std::span<const Tick> ticks,
+                      std::size_t skipped_rows) {
+    TickCacheHeader header{};
+    std::memcpy(header.magic, TickCacheHeader::kMagic, sizeof(header.magic));
+    header.version = TickCacheHeader::kVersion;
+    header.tick_size = sizeof(Tick);
+    header.source_size = key.size;
+    header.source_mtime_ns = key.mtime_ns;
+    header.source_hash = key.hash;
+    header.tick_count = ticks.size();
+    header.skipped_rows = skipped_rows;
+    header.path_size = static_cast<std::uint32_t>(key.path.size());
+    header.tick_offset = (sizeof(header) + key.path.size() + alignof(Tick) - 1) / alignof(Tick) * alignof(Tick);
+
+    // Concurrent runs each write their own file; the last rename wins
+    const std::string tmp = path + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        static const char zeros[alignof(Tick)] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(key.path.data(), static_cast<std::streamsize>(key.path.size()));
+        out.write(zeros, static_cast<std::streamsize>(header.tick_offset - sizeof(header) - key.path.size()));
+        out.write(reinterpret_cast<const char*>(ticks.data()), static_cast<std::streamsize>(ticks.size_bytes()));
+        out.flush();
+        if (!out) {
+            std::remove(tmp.c_str());
+            std::cerr << "[WARN] Cannot write tick cache " << path << "\n";
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), path.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        std::cerr << "[WARN] Cannot write tick cache " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace AlgoCatalyst
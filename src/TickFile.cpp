@@ -0,0 +1,245 @@
+#include "TickFile.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace AlgoCatalyst {
+
+static_assert(std::endian::native == std::endian::little, "tick files are little-endian");
+
+namespace {
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    const std::uint64_t a = TickFileHeader::kAlignment;
+    return (offset + a - 1) / a * a;
+}
+
+void writePadding(std::ofstream& out, std::uint64_t& offset, std::uint64_t target) {
+    static const char zeros[TickFileHeader::kAlignment] = {};
+    out.write(zeros, static_cast<std::streamsize>(target - offset));
+    offset = target;
+}
+
+template <typename T>
+void writeValue(std::ofstream& out, std::uint64_t& offset, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    offset += sizeof(T);
+}
+
+} // namespace
+
+std::shared_ptr<const ColumnarTickFile> ColumnarTickFile::open(const std::string& path) {
+    auto fail = [&path](const char* reason) {
+        std::cerr << "Error: " << path << ": " << reason << std::endl;
+        return nullptr;
+    };
+
+    std::shared_ptr<ColumnarTickFile> tf(new ColumnarTickFile());
+    if (!tf->file_.open(path)) return fail("cannot open file");
+
+    const std::size_t size = tf->file_.size();
+    const char* data = tf->file_.data();
+    TickFileHeader header;
+    if (size < sizeof(header)) return fail("not a tick file (too short)");
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, TickFileHeader::kMagic, sizeof(header.magic)) != 0) {
+        return fail("not a tick file (bad magic)");
+    }
+    if (header.version != TickFileHeader::kVersion) return fail("unsupported tick file version");
+    if (header.header_size < sizeof(header) || header.header_size > size) return fail("corrupt header");
+
+    // Columns: 8-byte aligned and fully inside the file
+    const std::uint64_t rows = header.row_count;
+    if (rows > size / 8) return fail("corrupt header (row count)");
+    for (std::uint64_t offset : header.column_offset) {
+        if (offset % 8 != 0 || offset < header.header_size || offset > size || size - offset < rows * 8) {
+            return fail("corrupt column directory");
+        }
+    }
+
+    // Symbol table: {first_row u64, row_count u64, name_length u32, name} per symbol, 8-byte aligned
+    if (header.symbol_table_offset > size || size - header.symbol_table_offset < header.symbol_table_size) {
+        return fail("corrupt symbol table");
+    }
+    const char* p = data + header.symbol_table_offset;
+    const char* const table_end = p + header.symbol_table_size;
+    for (std::uint32_t s = 0; s < header.symbol_count; ++s) {
+        SymbolRange range;
+        std::uint32_t name_length = 0;
+        if (table_end - p < 20) return fail("corrupt symbol table");
+        std::memcpy(&range.first_row, p, 8);
+        std::memcpy(&range.row_count, p + 8, 8);
+        std::memcpy(&name_length, p + 16, 4);
+        p += 20;
+        if (static_cast<std::uint64_t>(table_end - p) < name_length) return fail("corrupt symbol table");
+        range.name.assign(p, name_length);
+        p += name_length;
+        p += (8 - (static_cast<std::uint64_t>(p - data) % 8)) % 8;
+        if (range.first_row > rows || rows - range.first_row < range.row_count) {
+            return fail("symbol rows out of range");
+        }
+        tf->symbols_.push_back(std::move(range));
+    }
+
+    tf->rows_ = rows;
+    auto column = [data](std::uint64_t offset) { return data + offset; };
+    tf->timestamps_ = reinterpret_cast<const std::int64_t*>(column(header.column_offset[0]));
+    tf->prices_     = reinterpret_cast<const double*>(column(header.column_offset[1]));
+    tf->volumes_    = reinterpret_cast<const std::int64_t*>(column(header.column_offset[2]));
+    tf->bid_sizes_  = reinterpret_cast<const double*>(column(header.column_offset[3]));
+    tf->ask_sizes_  = reinterpret_cast<const double*>(column(header.column_offset[4]));
+    tf->highs_      = reinterpret_cast<const double*>(column(header.column_offset[5]));
+    tf->lows_       = reinterpret_cast<const double*>(column(header.column_offset[6]));
+    return tf;
+}
+
+bool ColumnarTickFile::isTickFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(TickFileHeader::kMagic)] = {};
+    in.read(magic, sizeof(magic));
+    return in.gcount() == sizeof(magic) && std::memcmp(magic, TickFileHeader::kMagic, sizeof(magic)) == 0;
+}
+
+const ColumnarTickFile::SymbolRange* ColumnarTickFile::findSymbol(std::string_view name) const {
+    for (const auto& range : symbols_) {
+        if (range.name == name) return &range;
+    }
+    return nullptr;
+}
+
+std::vector<RowRange> ColumnarTickFile::selectRows(const SymbolRange& range, const TickFilter& filter) const {
+    const std::int64_t* first = timestamps_ + range.first_row;
+    const std::int64_t* last = first + range.row_count;
+    const std::int64_t* end = std::lower_bound(first, last, filter.end_us);
+    const std::int64_t* p = std::lower_bound(first, end, filter.start_us);
+
+    std::vector<RowRange> ranges;
+    while (p < end) {
+        // Jump to the next passing timestamp, then to the end of its session
+        p = std::lower_bound(p, end, filter.nextInside(*p));
+        if (p == end) break;
+        const std::int64_t* stop = std::lower_bound(p, end, filter.insideUntil(*p));
+        ranges.push_back({static_cast<std::uint64_t>(p - timestamps_), static_cast<std::uint64_t>(stop - timestamps_)});
+        p = stop;
+    }
+    return ranges;
+}
+
+void ColumnarTickFile::readTick(std::size_t row, SymbolId symbol, Tick& out) const {
+    out.timestamp_us = timestamps_[row];
+    out.price        = prices_[row];
+    out.volume       = volumes_[row];
+    out.bid_size     = bid_sizes_[row];
+    out.ask_size     = ask_sizes_[row];
+    out.high         = highs_[row];
+    out.low          = lows_[row];
+    out.symbol_id    = symbol;
+}
+
+std::size_t sortByTimestamp(std::vector<Tick>& ticks) {
+    std::size_t out_of_order = 0;
+    for (std::size_t i = 1; i < ticks.size(); ++i) {
+        if (ticks[i].timestamp_us < ticks[i - 1].timestamp_us) ++out_of_order;
+    }
+    if (out_of_order == 0) return 0;
+
+    // Sort row indices rather than the ticks: std::stable_sort's scratch
+    // buffer is not allocated with Tick's 64-byte alignment
+    std::vector<std::size_t> order(ticks.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return ticks[a].timestamp_us < ticks[b].timestamp_us;
+    });
+    std::vector<Tick> sorted;
+    sorted.reserve(ticks.size());
+    for (std::size_t i : order) sorted.push_back(ticks[i]);
+    ticks = std::move(sorted);
+    return out_of_order;
+}
+
+bool allSortedByTimestamp(const std::string& path,
+                          const std::vector<std::pair<std::string, std::span<const Tick>>>& series) {
+    for (const auto& [name, ticks] : series) {
+        auto unsorted = std::is_sorted_until(ticks.begin(), ticks.end(), [](const Tick& a, const Tick& b) {
+            return a.timestamp_us < b.timestamp_us;
+        });
+        if (unsorted != ticks.end()) {
+            std::cerr << "Error: Cannot write " << path << ": ticks for " << name
+                      << " are not sorted by timestamp (row " << (unsorted - ticks.begin()) << ")" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ColumnarTickFile::write(const std::string& path,
+                             const std::vector<std::pair<std::string, std::span<const Tick>>>& series) {
+    if (!allSortedByTimestamp(path, series)) return false;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot create file " << path << std::endl;
+        return false;
+    }
+
+    TickFileHeader header{};
+    std::memcpy(header.magic, TickFileHeader::kMagic, sizeof(header.magic));
+    header.version = TickFileHeader::kVersion;
+    header.header_size = sizeof(TickFileHeader);
+    header.symbol_count = static_cast<std::uint32_t>(series.size());
+    for (const auto& [name, ticks] : series) {
+        header.row_count += ticks.size();
+        header.symbol_table_size += (20 + name.size() + 7) / 8 * 8;
+    }
+
+    // Layout: header | symbol table | 64-byte aligned columns
+    header.symbol_table_offset = sizeof(TickFileHeader);
+    std::uint64_t offset = alignUp(header.symbol_table_offset + header.symbol_table_size);
+    for (std::size_t c = 0; c < TickFileHeader::kColumns; ++c) {
+        header.column_offset[c] = offset;
+        offset = alignUp(offset + header.row_count * 8);
+    }
+
+    offset = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    offset += sizeof(header);
+
+    std::uint64_t first_row = 0;
+    for (const auto& [name, ticks] : series) {
+        writeValue(out, offset, first_row);
+        writeValue(out, offset, static_cast<std::uint64_t>(ticks.size()));
+        writeValue(out, offset, static_cast<std::uint32_t>(name.size()));
+        out.write(name.data(), static_cast<std::streamsize>(name.size()));
+        offset += name.size();
+        writePadding(out, offset, (offset + 7) / 8 * 8);
+        first_row += ticks.size();
+    }
+
+    // Column c holds one field of every row, symbols back to back
+    auto writeColumn = [&](std::size_t c, auto field) {
+        writePadding(out, offset, header.column_offset[c]);
+        for (const auto& entry : series) {
+            for (const Tick& tick : entry.second) {
+                writeValue(out, offset, field(tick));
+            }
+        }
+    };
+    writeColumn(0, [](const Tick& t) { return t.timestamp_us; });
+    writeColumn(1, [](const Tick& t) { return t.price; });
+    writeColumn(2, [](const Tick& t) { return t.volume; });
+    writeColumn(3, [](const Tick& t) { return t.bid_size; });
+    writeColumn(4, [](const Tick& t) { return t.ask_size; });
+    writeColumn(5, [](const Tick& t) { return t.high; });
+    writeColumn(6, [](const Tick& t) { return t.low; });
+
+    out.flush();
+    if (!out) {
+        std::cerr << "Error: Failed writing " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace AlgoCatalyst
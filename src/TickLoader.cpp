@@ -0,0 +1,479 @@
+#include "Engine.h"
+#include "MappedFile.h"
+#include "StreamingTickReader.h"
+#include "Timestamp.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+namespace AlgoCatalyst {
+
+namespace {
+
+const char* const kColumnNames[] = {"timestamp", "price", "volume", "bid_size", "ask_size", "high", "low"};
+constexpr std::size_t kMaxColumns = sizeof(kColumnNames) / sizeof(kColumnNames[0]);
+constexpr std::size_t kRequiredColumns = 5;
+
+// Leading whitespace and a '+' sign are accepted, as std::stod/std::stoll did
+const char* skipNumberPrefix(const char* p, const char* end) {
+    while (p < end && std::isspace(static_cast<unsigned char>(*p))) ++p;
+    if (p + 1 < end && *p == '+' && p[1] != '-') ++p;
+    return p;
+}
+
+bool parseDouble(std::string_view field, double& out) {
+    const char* end = field.data() + field.size();
+    const char* p = skipNumberPrefix(field.data(), end);
+    auto [ptr, ec] = std::from_chars(p, end, out);
+    if (ec == std::errc() && (ptr == end || (*ptr != 'x' && *ptr != 'X'))) return true;
+    if (ec == std::errc::result_out_of_range) return false;
+
+    // Spellings from_chars rejects (hex floats); strtod needs a terminated copy
+    std::string copy(field);
+    char* stop = nullptr;
+    errno = 0;
+    out = std::strtod(copy.c_str(), &stop);
+    return stop != copy.c_str() && errno != ERANGE;
+}
+
+bool parseInt(std::string_view field, std::int64_t& out) {
+    const char* end = field.data() + field.size();
+    const char* p = skipNumberPrefix(field.data(), end);
+    return std::from_chars(p, end, out).ec == std::errc();
+}
+
+enum class RowStatus { Ok, TooFewColumns, ParseError, Invalid, NonMonotonic };
+
+// Parse one data row (without its line terminator) in place. On TooFewColumns
+// 'detail' is the column count; on ParseError it is the failing column index.
+RowStatus parseTickRow(std::string_view line, TimestampParser& timestamps, Tick& tick, std::size_t& detail) {
+    std::string_view fields[kMaxColumns];
+    std::size_t n = 0;
+    std::size_t pos = 0;
+    // Same splitting as getline(',') did: a trailing comma does not add an empty field
+    while (pos < line.size() && n < kMaxColumns) {
+        std::size_t comma = line.find(',', pos);
+        if (comma == std::string_view::npos) {
+            fields[n++] = line.substr(pos);
+            break;
+        }
+        fields[n++] = line.substr(pos, comma - pos);
+        pos = comma + 1;
+    }
+
+    if (n < kRequiredColumns) {
+        detail = n;
+        return RowStatus::TooFewColumns;
+    }
+
+    tick = Tick{};
+    tick.timestamp_us = timestamps.parse(fields[0]);
+    bool ok = true;
+    if (!parseDouble(fields[1], tick.price))    { detail = 1; ok = false; }
+    else if (!parseInt(fields[2], tick.volume))      { detail = 2; ok = false; }
+    else if (!parseDouble(fields[3], tick.bid_size)) { detail = 3; ok = false; }
+    else if (!parseDouble(fields[4], tick.ask_size)) { detail = 4; ok = false; }
+    else if (n > 5 && !parseDouble(fields[5], tick.high)) { detail = 5; ok = false; }
+    else if (n > 6 && !parseDouble(fields[6], tick.low))  { detail = 6; ok = false; }
+    if (!ok) return RowStatus::ParseError;
+
+    if (n <= 5) tick.high = tick.price;
+    if (n <= 6) tick.low = tick.price;
+
+    // Data sanity: price and volume must be positive
+    if (tick.price <= 0.0 || tick.volume < 0) return RowStatus::Invalid;
+    return RowStatus::Ok;
+}
+
+// Row count estimate from the line density of the first 64 KB
+std::size_t estimateRows(std::string_view text) {
+    std::size_t sample = std::min<std::size_t>(text.size(), 64 * 1024);
+    std::size_t lines = static_cast<std::size_t>(std::count(text.begin(), text.begin() + sample, '\n'));
+    if (lines == 0) return 0;
+    return text.size() / (sample / lines + 1) + 1;
+}
+
+// A skipped or suspicious row, reported after parsing so chunks parsed in
+// parallel still warn in file order. 'line' is relative to the chunk.
+struct RowIssue {
+    std::size_t line;
+    RowStatus status;
+    std::size_t detail;
+};
+
+struct ChunkResult {
+    std::vector<Tick> ticks;
+    std::vector<RowIssue> issues;
+    std::size_t lines = 0;
+    std::size_t first_tick_line = 0;   // Chunk-relative line of ticks.front()
+    std::size_t skipped = 0;
+};
+
+// Parse whole lines in [begin, end). The first tick's timestamp is not
+// checked for monotonicity here; the caller compares it with the previous chunk.
+// Rows whose timestamp fails 'filter' are dropped before any other column is
+// parsed, and are neither validated nor counted as skipped.
+void parseChunk(const char* begin, const char* end, const TickFilter& filter, ChunkResult& out) {
+    std::string_view chunk(begin, static_cast<std::size_t>(end - begin));
+    const bool filtered = !filter.passesAll();
+    // A filtered parse may keep a handful of rows: sizing for every row would
+    // hold the whole file's worth of ticks for the life of the series
+    if (!filtered) out.ticks.reserve(estimateRows(chunk));
+
+    TimestampParser timestamps;
+    std::int64_t prev_timestamp = 0;
+    const char* p = begin;
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        const char* line_end = nl ? nl : end;
+        std::string_view line(p, static_cast<std::size_t>(line_end - p));
+        p = nl ? nl + 1 : end;
+        ++out.lines;
+
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty() || line[0] == '#') continue;
+        if (filtered && !filter.contains(timestamps.parse(line.substr(0, line.find(','))))) continue;
+
+        Tick tick;
+        std::size_t detail = 0;
+        RowStatus status = parseTickRow(line, timestamps, tick, detail);
+        if (status != RowStatus::Ok) {
+            out.issues.push_back({out.lines, status, detail});
+            ++out.skipped;
+            continue;
+        }
+
+        // Warn on non-monotonic timestamps but keep the tick
+        if (prev_timestamp > 0 && tick.timestamp_us < prev_timestamp) {
+            out.issues.push_back({out.lines, RowStatus::NonMonotonic, 0});
+        }
+        prev_timestamp = tick.timestamp_us;
+
+        if (out.ticks.empty()) out.first_tick_line = out.lines;
+        out.ticks.push_back(std::move(tick));
+    }
+}
+
+void reportIssue(std::size_t line_num, RowStatus status, std::size_t detail) {
+    switch (status) {
+    case RowStatus::TooFewColumns:
+        std::cerr << "[WARN] Line " << line_num << ": expected 5 columns, got "
+                  << detail << " — skipping\n";
+        break;
+    case RowStatus::ParseError:
+        std::cerr << "[WARN] Line " << line_num << ": parse error (bad "
+                  << kColumnNames[detail] << ") — skipping\n";
+        break;
+    case RowStatus::Invalid:
+        std::cerr << "[WARN] Line " << line_num << ": invalid price/volume — skipping\n";
+        break;
+    case RowStatus::NonMonotonic:
+        std::cerr << "[WARN] Line " << line_num << ": non-monotonic timestamp\n";
+        break;
+    case RowStatus::Ok:
+        break;
+    }
+}
+
+// Split [begin, end) into about 'n' ranges that each end on a line boundary
+std::vector<std::pair<const char*, const char*>> splitLines(const char* begin, const char* end, std::size_t n) {
+    std::vector<std::pair<const char*, const char*>> ranges;
+    const std::size_t total = static_cast<std::size_t>(end - begin);
+    const char* start = begin;
+    for (std::size_t i = 1; i <= n && start < end; ++i) {
+        const char* cut = (i == n) ? end : begin + total / n * i;
+        if (cut < start) cut = start;
+        if (cut < end) {
+            const char* nl = static_cast<const char*>(std::memchr(cut, '\n', static_cast<std::size_t>(end - cut)));
+            cut = nl ? nl + 1 : end;
+        }
+        if (cut > start) ranges.emplace_back(start, cut);
+        start = cut;
+    }
+    return ranges;
+}
+
+} // namespace
+
+std::vector<Tick> TickLoader::loadFromCSV(const std::string& filepath, const TickLoadOptions& options) {
+    std::vector<Tick> ticks;
+    MappedFile file(filepath);
+
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file " << filepath << std::endl;
+        return ticks;
+    }
+
+    TickCacheKey cache_key;
+    const std::string cache_path = TickCache::pathFor(filepath);
+    const bool cached = options.cache != TickCacheMode::Off && TickCacheKey::of(filepath, file.view(), cache_key);
+    if (cached && options.cache == TickCacheMode::Use) {
+        std::size_t skipped = 0;
+        if (TickCache::read(cache_path, cache_key, options.filter, ticks, skipped)) {
+            if (skipped > 0 && options.filter.passesAll()) {
+                std::cerr << "[INFO] Skipped " << skipped << " malformed rows.\n";
+            }
+            if (options.verbose) {
+                std::cout << "Loaded " << ticks.size() << " ticks from " << filepath << " (cached)" << std::endl;
+            }
+            return ticks;
+        }
+    }
+
+    // Line 1 is the header
+    const char* const end = file.data() + file.size();
+    const char* body = file.size() ? static_cast<const char*>(std::memchr(file.data(), '\n', file.size())) : nullptr;
+    body = body ? body + 1 : end;
+
+    unsigned threads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t min_chunk = std::max<std::size_t>(options.min_chunk_bytes, 1);
+    std::size_t wanted = std::min<std::size_t>(threads, static_cast<std::size_t>(end - body) / min_chunk);
+    auto ranges = splitLines(body, end, std::max<std::size_t>(wanted, 1));
+
+    std::vector<ChunkResult> chunks(ranges.size());
+    if (ranges.size() > 1) {
+        std::vector<std::thread> workers;
+        workers.reserve(ranges.size() - 1);
+        for (std::size_t c = 1; c < ranges.size(); ++c) {
+            workers.emplace_back(parseChunk, ranges[c].first, ranges[c].second, std::cref(options.filter),
+                                 std::ref(chunks[c]));
+        }
+        parseChunk(ranges[0].first, ranges[0].second, options.filter, chunks[0]);
+        for (auto& t : workers) {
+            t.join();
+        }
+    } else if (!ranges.empty()) {
+        parseChunk(ranges[0].first, ranges[0].second, options.filter, chunks[0]);
+    }
+
+    // Report in file order, adding the monotonicity check each chunk deferred
+    // for its first tick, then stitch the per-chunk buffers
+    std::size_t line_base = 1;   // Lines before the chunk (header included)
+    std::size_t skipped = 0;
+    std::size_t total = 0;
+    std::int64_t prev_timestamp = 0;
+    for (auto& chunk : chunks) {
+        bool boundary_issue = !chunk.ticks.empty() && prev_timestamp > 0 &&
+                              chunk.ticks.front().timestamp_us < prev_timestamp;
+        for (const auto& issue : chunk.issues) {
+            if (boundary_issue && issue.line > chunk.first_tick_line) {
+                reportIssue(line_base + chunk.first_tick_line, RowStatus::NonMonotonic, 0);
+                boundary_issue = false;
+            }
+            reportIssue(line_base + issue.line, issue.status, issue.detail);
+        }
+        if (boundary_issue) {
+            reportIssue(line_base + chunk.first_tick_line, RowStatus::NonMonotonic, 0);
+        }
+
+        if (!chunk.ticks.empty()) prev_timestamp = chunk.ticks.back().timestamp_us;
+        line_base += chunk.lines;
+        skipped += chunk.skipped;
+        total += chunk.ticks.size();
+    }
+
+    if (chunks.size() == 1) {
+        ticks = std::move(chunks[0].ticks);
+    } else {
+        ticks.reserve(total);
+        for (auto& chunk : chunks) {
+            std::move(chunk.ticks.begin(), chunk.ticks.end(), std::back_inserter(ticks));
+            std::vector<Tick>().swap(chunk.ticks);   // Release as we go to cap peak memory
+        }
+    }
+
+    if (skipped > 0) {
+        std::cerr << "[INFO] Skipped " << skipped << " malformed rows.\n";
+    }
+
+    // The cache holds the whole file, so only an unfiltered parse can write it
+    if (cached && options.filter.passesAll()) {
+        TickCache::write(cache_path, cache_key, ticks, skipped);
+    }
+
+    if (options.verbose) {
+        std::cout << "Loaded " << ticks.size() << " ticks from " << filepath << std::endl;
+    }
+
+    return ticks;
+}
+
+std::int64_t TickLoader::parseTimestamp(std::string_view ts_str) {
+    return TimestampParser().parse(ts_str);
+}
+
+// StreamingTickReader Implementation
+StreamingTickReader::StreamingTickReader(std::string path, SymbolId symbol, const TickFilter& filter,
+                                         std::size_t chunk_ticks)
+    : path_(std::move(path)), symbol_(symbol), filter_(filter), chunk_ticks_(std::max<std::size_t>(chunk_ticks, 1)) {
+    fd_ = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "Error: Cannot open file " << path_ << std::endl;
+        return;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    for (auto& chunk : chunks_) chunk.ticks.reserve(chunk_ticks_);
+    start();
+}
+
+StreamingTickReader::~StreamingTickReader() {
+    stop();
+    if (fd_ >= 0) ::close(fd_);
+}
+
+bool StreamingTickReader::rewind() {
+    if (fd_ < 0) return false;
+    stop();
+    if (::lseek(fd_, 0, SEEK_SET) != 0) return false;
+    ready_[0] = ready_[1] = false;
+    current_ = &empty_;
+    pos_ = 0;
+    slot_ = 0;
+    holding_ = false;
+    at_end_ = false;
+    run_start_ = nullptr;
+    start();
+    return true;
+}
+
+void StreamingTickReader::start() {
+    stopping_ = false;
+    reader_ = std::thread(&StreamingTickReader::readAhead, this);
+}
+
+void StreamingTickReader::stop() {
+    if (!reader_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    reader_.join();
+}
+
+const Tick* StreamingTickReader::nextChunk() {
+    if (at_end_) return nullptr;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (holding_) {
+        if (chunks_[slot_].last) {
+            at_end_ = true;
+            return nullptr;
+        }
+        // The chunk goes back to the reader; keep the run start fills may still need
+        if (run_start_ && run_start_ >= current_->data() && run_start_ < current_->data() + current_->size()) {
+            saved_run_start_ = *run_start_;
+            run_start_ = &saved_run_start_;
+        }
+        ready_[slot_] = false;
+        holding_ = false;
+        slot_ ^= 1;
+        cv_.notify_all();
+    }
+    cv_.wait(lock, [&] { return ready_[slot_]; });
+    holding_ = true;
+    current_ = &chunks_[slot_].ticks;
+    pos_ = 0;
+    if (current_->empty()) {   // Only the final chunk can be empty
+        at_end_ = true;
+        return nullptr;
+    }
+    return &current_->front();
+}
+
+void StreamingTickReader::readAhead() {
+    int slot = 0;
+    std::vector<Tick>* out = &chunks_[slot].ticks;
+    out->clear();
+
+    // Hand the filled chunk to the consumer and wait for the other one to be free
+    auto publish = [&](bool last) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        chunks_[slot].last = last;
+        ready_[slot] = true;
+        cv_.notify_all();
+        if (last) return false;
+        slot ^= 1;
+        cv_.wait(lock, [&] { return !ready_[slot] || stopping_; });
+        if (stopping_) return false;
+        out = &chunks_[slot].ticks;
+        out->clear();
+        return true;
+    };
+
+    const bool filtered = !filter_.passesAll();
+    TimestampParser timestamps;
+    std::int64_t prev_timestamp = 0;
+    std::size_t line_num = 0;
+    std::size_t skipped = 0;
+
+    // Same rules as parseChunk(), reporting as rows are read; false once stopped
+    auto processLine = [&](std::string_view line) {
+        if (++line_num == 1) return true;   // Header
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (line.empty() || line[0] == '#') return true;
+        if (filtered && !filter_.contains(timestamps.parse(line.substr(0, line.find(','))))) return true;
+
+        Tick tick;
+        std::size_t detail = 0;
+        RowStatus status = parseTickRow(line, timestamps, tick, detail);
+        if (status != RowStatus::Ok) {
+            reportIssue(line_num, status, detail);
+            ++skipped;
+            return true;
+        }
+        if (prev_timestamp > 0 && tick.timestamp_us < prev_timestamp) {
+            reportIssue(line_num, RowStatus::NonMonotonic, 0);
+        }
+        prev_timestamp = tick.timestamp_us;
+
+        tick.symbol_id = symbol_;
+        out->push_back(std::move(tick));
+        return out->size() < chunk_ticks_ || publish(false);
+    };
+
+    // Lines are parsed straight out of the read buffer; a partial last line
+    // moves to the front for the next read
+    std::vector<char> buffer(kReadBytes);
+    std::size_t carry = 0;
+    for (;;) {
+        ssize_t n = ::read(fd_, buffer.data() + carry, buffer.size() - carry);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error: Read failed on " << path_ << ": " << std::strerror(errno) << std::endl;
+            break;
+        }
+        const bool eof = n == 0;
+        const char* p = buffer.data();
+        const char* const end = p + carry + static_cast<std::size_t>(n);
+        while (p < end) {
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            if (!nl && !eof) break;
+            const char* line_end = nl ? nl : end;
+            if (!processLine(std::string_view(p, static_cast<std::size_t>(line_end - p)))) return;
+            p = nl ? nl + 1 : end;
+        }
+        if (eof) break;
+
+        carry = static_cast<std::size_t>(end - p);
+        std::memmove(buffer.data(), p, carry);
+        if (carry == buffer.size()) buffer.resize(buffer.size() * 2);   // A line longer than the buffer
+    }
+
+    if (skipped > 0) {
+        std::cerr << "[INFO] Skipped " << skipped << " malformed rows.\n";
+    }
+    publish(true);
+}
+
+} // namespace AlgoCatalyst
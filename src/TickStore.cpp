@@ -0,0 +1,79 @@
+#include "TickStore.h"
+#include "Engine.h"
+#include <algorithm>
+#include <iterator>
+
+namespace AlgoCatalyst {
+
+TickStore& TickStore::global() {
+    static TickStore store;
+    return store;
+}
+
+TickSeriesPtr TickStore::load(const std::string& path, const std::string& symbol, const TickFilter& filter) {
+    Key key{path, internSymbol(symbol), filter};
+    TickSeriesPtr whole;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = series_.find(key);
+        if (it != series_.end()) return it->second;
+        if (!filter.passesAll()) {
+            auto all = series_.find(Key{path, key.symbol, TickFilter{}});
+            if (all != series_.end()) whole = all->second;
+        }
+    }
+
+    // Parse outside the lock (or cut the subset from the whole file's cached
+    // series); if two threads race, the first insert wins
+    std::vector<Tick> ticks;
+    if (whole) {
+        std::copy_if(whole->begin(), whole->end(), std::back_inserter(ticks),
+                     [&filter](const Tick& t) { return filter.contains(t.timestamp_us); });
+    } else {
+        TickLoadOptions options;
+        options.filter = filter;
+        options.cache = cacheMode();
+        ticks = TickLoader::loadFromCSV(path, options);
+    }
+    if (ticks.empty()) return nullptr;
+    TickSeriesPtr series = adopt(std::move(ticks), key.symbol);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return series_.emplace(std::move(key), std::move(series)).first->second;
+}
+
+TickSeriesPtr TickStore::adopt(std::vector<Tick> ticks, SymbolId symbol) {
+    for (auto& tick : ticks) {
+        tick.symbol_id = symbol;
+    }
+    return std::make_shared<const std::vector<Tick>>(std::move(ticks));
+}
+
+void TickStore::evict(const std::string& path, const std::string& symbol) {
+    SymbolId id;
+    if (!SymbolTable::global().find(symbol, id)) return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::erase_if(series_, [&](const auto& entry) { return entry.first.path == path && entry.first.symbol == id; });
+}
+
+void TickStore::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    series_.clear();
+}
+
+std::size_t TickStore::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return series_.size();
+}
+
+void TickStore::setCacheMode(TickCacheMode mode) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_mode_ = mode;
+}
+
+TickCacheMode TickStore::cacheMode() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_mode_;
+}
+
+} // namespace AlgoCatalyst
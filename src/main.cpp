@@ -3,20 +3,106 @@
 #include "AI_Regime.h"
 #include "PerformanceAnalyzer.h"
 #include "ConfigLoader.h"
+#include "Sweep.h"
+#include "TickBlocks.h"
+#include "TickFile.h"
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <iomanip>
 #include <memory>
+#include <span>
 #include <string>
+#include <vector>
+#include <sstream>
+#include <cstdio>
 #include <cstring>
 
 using namespace AlgoCatalyst;
 
+// Split a comma-separated CLI list ("a.csv,b.csv") into its items
+static std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Split --data and --symbol into one symbol per data file; false (after
+// printing an error) if the lists do not pair up
+static bool splitDataAndSymbols(const std::string& data, const std::string& symbol,
+                                std::vector<std::string>& files, std::vector<std::string>& symbols) {
+    files = splitList(data);
+    symbols = splitList(symbol);
+    if (!files.empty() && files.size() == symbols.size()) return true;
+    std::cerr << "Error: --data lists " << files.size() << " file(s) but --symbol lists "
+              << symbols.size() << " symbol(s); give one symbol per data file\n";
+    return false;
+}
+
+// Parse "HH:MM[:SS]" into seconds of day; false if malformed
+static bool parseTimeOfDay(const std::string& text, std::int64_t& seconds) {
+    int h = 0, m = 0, sec = 0;
+    char extra = 0;
+    int fields = std::sscanf(text.c_str(), "%d:%d:%d%c", &h, &m, &sec, &extra);
+    if (fields != 2 && fields != 3) return false;
+    if (h < 0 || h > 24 || m < 0 || m > 59 || sec < 0 || sec > 59) return false;
+    seconds = h * 3600 + m * 60 + sec;
+    return seconds <= TickFilter::kSecondsPerDay;
+}
+
+// --from / --to / --session
+static bool isFilterOption(const char* arg) {
+    return std::strcmp(arg, "--from") == 0 || std::strcmp(arg, "--to") == 0 || std::strcmp(arg, "--session") == 0;
+}
+
+// Apply one filter option to 'filter'; false (after printing an error) if the value is malformed
+static bool applyFilterOption(const std::string& option, const std::string& value, TickFilter& filter) {
+    if (option == "--session") {
+        std::size_t dash = value.find('-');
+        std::int64_t open = 0, close = 0;
+        if (dash == std::string::npos || !parseTimeOfDay(value.substr(0, dash), open) ||
+            !parseTimeOfDay(value.substr(dash + 1), close) || open >= close) {
+            std::cerr << "Error: --session expects HH:MM-HH:MM in UTC with open before close, got '" << value << "'\n";
+            return false;
+        }
+        filter.session_open_utc_s = open;
+        filter.session_close_utc_s = close;
+        return true;
+    }
+
+    // A bare date means midnight UTC
+    std::int64_t ts = TickLoader::parseTimestamp(value.size() == 10 ? value + "T00:00:00" : value);
+    if (ts == 0) {
+        std::cerr << "Error: " << option << " expects microseconds or an ISO 8601 time, got '" << value << "'\n";
+        return false;
+    }
+    (option == "--from" ? filter.start_us : filter.end_us) = ts;
+    return true;
+}
+
+// --scheduler auto|binary|radix; false (after printing an error) for anything else
+static bool parseScheduler(const std::string& value, SchedulerKind& kind) {
+    if (value == "auto") kind = SchedulerKind::Auto;
+    else if (value == "binary") kind = SchedulerKind::BinaryHeap;
+    else if (value == "radix") kind = SchedulerKind::RadixHeap;
+    else {
+        std::cerr << "Error: --scheduler expects auto, binary or radix, got '" << value << "'\n";
+        return false;
+    }
+    return true;
+}
+
 static void printUsage(const char* prog) {
     std::cout << "Usage: " << prog << " [OPTIONS]\n\n"
               << "Options:\n"
               << "  --config <path>     JSON config file (overridden by CLI flags)\n"
-              << "  --data <path>       Path to tick CSV file (default: data/tick_data.csv)\n"
-              << "  --symbol <sym>      Ticker symbol name (default: TICKER)\n"
+              << "  --data <path>       Path to tick CSV file; comma-separate for multiple symbols (default: data/tick_data.csv)\n"
+              << "  --dataset <dir>     Indexed dataset directory instead of --data; --symbol picks symbols (default: all)\n"
+              << "  --symbol <sym>      Ticker symbol name, one per --data file (default: TICKER)\n"
               << "  --latency <ms>      Simulated fill latency in ms (default: 200)\n"
               << "  --output <path>     Trade log CSV output path (default: trades.csv)\n"
               << "  --stop-loss <pct>   Hard stop-loss percent (default: 2.0)\n"
@@ -24,22 +110,276 @@ static void printUsage(const char* prog) {
               << "  --trailing <pct>    Trailing stop percent (default: 3.0)\n"
               << "  --slippage <bps>    Slippage in basis points (default: 5)\n"
               << "  --strategy <name>   Strategy: momentum|meanrev|breakout (default: momentum)\n"
-              << "  --help              Show this help message\n";
+              << "  --threads <n>       Worker threads for multi-symbol runs (default: 1)\n"
+              << "  --scheduler <name>  Event queue: auto|binary|radix (default: auto, radix when all ticks are sorted)\n"
+              << "  --from <time>       Load only ticks at or after this time (microseconds or ISO 8601, e.g. 2024-01-02)\n"
+              << "  --to <time>         Load only ticks before this time\n"
+              << "  --session <hh:mm-hh:mm>  Load only ticks inside this daily UTC session (e.g. 13:30-20:00)\n"
+              << "  --stream            Read CSV ticks as the run consumes them (bounded memory) instead of loading them\n"
+              << "  --no-cache          Parse CSVs without reading or writing their .tickcache side-car\n"
+              << "  --rebuild-cache     Re-parse CSVs and overwrite their .tickcache side-car\n"
+              << "  --help              Show this help message\n\n"
+              << "Subcommands:\n"
+              << "  sweep               In-process parameter grid search (see '" << prog << " sweep --help')\n"
+              << "  convert             Convert tick CSVs to a .actk or .actz tick file (see '" << prog << " convert --help')\n"
+              << "  dataset             Index or verify a partitioned dataset directory (see '" << prog << " dataset --help')\n";
+}
+
+// Parse a comma-separated list of numbers ("1,1.5,2")
+static std::vector<double> parseValues(const std::string& list) {
+    std::vector<double> values;
+    for (const auto& item : splitList(list)) {
+        values.push_back(std::stod(item));
+    }
+    return values;
+}
+
+static void printSweepUsage(const char* prog) {
+    std::cout << "Usage: " << prog << " sweep [OPTIONS]\n\n"
+              << "Runs every combination of the listed values on a thread pool over shared tick data.\n"
+              << "Value flags take a comma-separated list; a single value pins the parameter.\n\n"
+              << "Options:\n"
+              << "  --data <path>            Tick CSV file(s), comma-separated (default: data/tick_data.csv)\n"
+              << "  --symbol <sym>           Symbol per data file (default: TICKER)\n"
+              << "  --strategy <name>        Strategy: momentum|meanrev|breakout (default: momentum)\n"
+              << "  --stop-loss <list>       Stop-loss percents (default: 2.0)\n"
+              << "  --take-profit <list>     Take-profit percents (default: 6.0)\n"
+              << "  --trailing <list>        Trailing stop percents (default: 3.0)\n"
+              << "  --min-rel-volume <list>  Minimum relative volume (default: strategy default)\n"
+              << "  --slippage <list>        Slippage in basis points (default: 5)\n"
+              << "  --latency <ms>           Simulated fill latency in ms (default: 200)\n"
+              << "  --from <time>, --to <time>, --session <hh:mm-hh:mm>\n"
+              << "                           Load only ticks in this window / daily UTC session (as for a run)\n"
+              << "  --threads <n>            Worker threads, 0 = all cores (default: 0)\n"
+              << "  --no-cache, --rebuild-cache\n"
+              << "                           Skip / rebuild the CSVs' .tickcache side-cars (as for a run)\n"
+              << "  --metric <name>          Rank by sharpe|pnl|profit_factor|win_rate (default: sharpe)\n"
+              << "  --top <n>                Rows to print (default: 10)\n"
+              << "  --output <path>          Results CSV, one row per combination (default: sweep_results.csv)\n";
+}
+
+static int runSweep(int argc, char* argv[]) {
+    std::string csv_file = "data/tick_data.csv";
+    std::string symbol = "TICKER";
+    std::string strategy_name = "momentum";
+    std::string output_file = "sweep_results.csv";
+    std::string metric = "sharpe";
+    double latency_ms = 200.0;
+    int threads = 0;
+    std::size_t top = 10;
+    SweepGrid grid;
+    TickFilter filter;
+    TickCacheMode cache_mode = TickCacheMode::Use;
+
+    try {
+        for (int i = 2; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+                printSweepUsage(argv[0]);
+                return 0;
+            } else if (std::strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+                csv_file = argv[++i];
+            } else if (std::strcmp(argv[i], "--symbol") == 0 && i + 1 < argc) {
+                symbol = argv[++i];
+            } else if (std::strcmp(argv[i], "--strategy") == 0 && i + 1 < argc) {
+                strategy_name = argv[++i];
+            } else if (std::strcmp(argv[i], "--stop-loss") == 0 && i + 1 < argc) {
+                grid.stop_loss_pct = parseValues(argv[++i]);
+            } else if (std::strcmp(argv[i], "--take-profit") == 0 && i + 1 < argc) {
+                grid.take_profit_pct = parseValues(argv[++i]);
+            } else if (std::strcmp(argv[i], "--trailing") == 0 && i + 1 < argc) {
+                grid.trailing_stop_pct = parseValues(argv[++i]);
+            } else if (std::strcmp(argv[i], "--min-rel-volume") == 0 && i + 1 < argc) {
+                grid.min_relative_volume = parseValues(argv[++i]);
+            } else if (std::strcmp(argv[i], "--slippage") == 0 && i + 1 < argc) {
+                grid.slippage_bps = parseValues(argv[++i]);
+            } else if (std::strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
+                latency_ms = std::stod(argv[++i]);
+            } else if (isFilterOption(argv[i]) && i + 1 < argc) {
+                if (!applyFilterOption(argv[i], argv[i + 1], filter)) return 1;
+                ++i;
+            } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                threads = std::stoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--no-cache") == 0) {
+                cache_mode = TickCacheMode::Off;
+            } else if (std::strcmp(argv[i], "--rebuild-cache") == 0) {
+                cache_mode = TickCacheMode::Rebuild;
+            } else if (std::strcmp(argv[i], "--metric") == 0 && i + 1 < argc) {
+                metric = argv[++i];
+            } else if (std::strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+                top = static_cast<std::size_t>(std::stoul(argv[++i]));
+            } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+                output_file = argv[++i];
+            } else {
+                std::cerr << "Error: Unknown sweep option: " << argv[i] << "\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Invalid sweep value: " << e.what() << "\n";
+        return 1;
+    }
+
+    std::vector<std::string> csv_files, symbols;
+    if (!splitDataAndSymbols(csv_file, symbol, csv_files, symbols)) return 1;
+
+    TickStore::global().setCacheMode(cache_mode);
+    ParameterSweep sweep(strategy_name, latency_ms);
+    sweep.setGrid(grid);
+    sweep.setThreads(threads > 0 ? static_cast<unsigned>(threads) : 0u);
+    for (std::size_t k = 0; k < csv_files.size(); ++k) {
+        if (!sweep.loadTickData(csv_files[k], symbols[k], filter)) {
+            std::cerr << "Error: Failed to load tick data from " << csv_files[k] << "\n";
+            return 1;
+        }
+    }
+
+    std::size_t total = sweep.combinations().size();
+    std::cout << "Sweeping " << total << " parameter combinations (strategy=" << strategy_name
+              << ", metric=" << metric << ")...\n";
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<SweepResult> results;
+    try {
+        results = sweep.run();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Sweep failed: " << e.what() << "\n";
+        return 1;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    std::cout << "Completed " << results.size() << " runs in " << elapsed.count() << " ms\n";
+
+    // CSV keeps grid order so files from different runs diff cleanly
+    if (!ParameterSweep::writeCSV(results, output_file)) return 1;
+
+    if (!ParameterSweep::sortByMetric(results, metric)) {
+        std::cerr << "Error: Unknown metric '" << metric << "' (sharpe|pnl|profit_factor|win_rate)\n";
+        return 1;
+    }
+    std::cout << "\nTop " << std::min(top, results.size()) << " results by " << metric << ":\n\n";
+    ParameterSweep::printTable(results, top);
+    std::cout << "\nFull results saved to " << output_file << "\n";
+    return 0;
+}
+
+static void printConvertUsage(const char* prog) {
+    std::cout << "Usage: " << prog << " convert --data <csv[,csv...]> --symbol <sym[,sym...]> --output <file.actk|file.actz>\n\n"
+              << "Writes the CSVs (one symbol per file) into one tick file; see docs/tick_format.md.\n"
+              << "An output ending in .actz is block-compressed, anything else is columnar (.actk).\n"
+              << "Any command that takes --data accepts the resulting file.\n";
+}
+
+static int runConvert(int argc, char* argv[]) {
+    std::string csv_file;
+    std::string symbol = "TICKER";
+    std::string output_file;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            printConvertUsage(argv[0]);
+            return 0;
+        } else if (std::strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+            csv_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--symbol") == 0 && i + 1 < argc) {
+            symbol = argv[++i];
+        } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_file = argv[++i];
+        } else {
+            std::cerr << "Error: Unknown convert option: " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    if (splitList(csv_file).empty() || output_file.empty()) {
+        printConvertUsage(argv[0]);
+        return 1;
+    }
+    std::vector<std::string> csv_files, symbols;
+    if (!splitDataAndSymbols(csv_file, symbol, csv_files, symbols)) return 1;
+
+    std::vector<std::vector<Tick>> loaded;
+    std::vector<std::pair<std::string, std::span<const Tick>>> series;
+    loaded.reserve(csv_files.size());
+    for (std::size_t k = 0; k < csv_files.size(); ++k) {
+        loaded.push_back(TickLoader::loadFromCSV(csv_files[k]));
+        if (loaded.back().empty()) {
+            std::cerr << "Error: Failed to load tick data from " << csv_files[k] << "\n";
+            return 1;
+        }
+        // Tick files are time-sorted; the loader keeps out-of-order rows where they were
+        if (std::size_t moved = sortByTimestamp(loaded.back())) {
+            std::cerr << "[WARN] " << csv_files[k] << ": sorted " << moved << " out-of-order row(s) by timestamp\n";
+        }
+        series.emplace_back(symbols[k], loaded.back());
+    }
+
+    const bool compressed = output_file.size() >= 5 && output_file.compare(output_file.size() - 5, 5, ".actz") == 0;
+    if (compressed ? !CompressedTickFile::write(output_file, series)
+                   : !ColumnarTickFile::write(output_file, series)) {
+        return 1;
+    }
+    std::size_t rows = 0;
+    for (const auto& ticks : loaded) rows += ticks.size();
+    std::cout << "Wrote " << rows << " ticks for " << series.size() << " symbol(s) to " << output_file << "\n";
+    return 0;
+}
+
+static void printDatasetUsage(const char* prog) {
+    std::cout << "Usage: " << prog << " dataset index <dir>\n"
+              << "       " << prog << " dataset verify <dir>\n\n"
+              << "A dataset is a directory with one subdirectory per symbol holding that symbol's tick\n"
+              << "files (.csv, .actk or .actz), e.g. <dir>/AAPL/2024-01-02.csv; see docs/tick_format.md.\n"
+              << "  index    Read every file once and write <dir>/manifest.csv (rows, time range, size, checksum)\n"
+              << "  verify   Check every file against the manifest; exits 1 if any changed\n"
+              << "Run on it with '" << prog << " --dataset <dir> [--symbol a,b,...]'.\n";
+}
+
+static int runDataset(int argc, char* argv[]) {
+    if (argc != 4 || (std::strcmp(argv[2], "index") != 0 && std::strcmp(argv[2], "verify") != 0)) {
+        printDatasetUsage(argv[0]);
+        return argc > 2 && (std::strcmp(argv[2], "--help") == 0 || std::strcmp(argv[2], "-h") == 0) ? 0 : 1;
+    }
+    if (std::strcmp(argv[2], "index") == 0) {
+        return Dataset::buildIndex(argv[3]) ? 0 : 1;
+    }
+    DatasetPtr dataset = Dataset::open(argv[3]);
+    if (!dataset) return 1;
+    std::size_t changed = dataset->verify();
+    std::cout << dataset->partitions().size() - changed << " of " << dataset->partitions().size()
+              << " partitions match the manifest\n";
+    return changed == 0 ? 0 : 1;
 }
 
 int main(int argc, char* argv[]) {
+    if (argc > 1 && std::strcmp(argv[1], "sweep") == 0) {
+        return runSweep(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "convert") == 0) {
+        return runConvert(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "dataset") == 0) {
+        return runDataset(argc, argv);
+    }
+
     std::string csv_file = "data/tick_data.csv";
+    std::string dataset_dir;
     std::string symbol = "TICKER";
+    bool symbol_given = false;
     std::string output_file = "trades.csv";
     std::string json_output_file;
     std::string strategy_name = "momentum";
     bool dry_run = false;
+    bool stream = false;
+    TickCacheMode cache_mode = TickCacheMode::Use;
     std::string config_file;
     double latency_ms = 200.0;
     double stop_loss_pct = 2.0;
     double take_profit_pct = 6.0;
     double trailing_stop_pct = 3.0;
     double slippage_bps = 5.0;
+    int threads = 1;
+    SchedulerKind scheduler = SchedulerKind::Auto;
+    TickFilter filter;
 
     // Pre-scan for --config so it loads before other flags
     for (int i = 1; i < argc; ++i) {
@@ -51,6 +391,8 @@ int main(int argc, char* argv[]) {
         try {
             AlgoCatalyst::ConfigLoader cfg = AlgoCatalyst::ConfigLoader::fromFile(config_file);
             csv_file         = cfg.getString("data",              csv_file);
+            dataset_dir      = cfg.getString("dataset",           dataset_dir);
+            symbol_given     = cfg.has("symbol");
             symbol           = cfg.getString("symbol",            symbol);
             output_file      = cfg.getString("output",            output_file);
             strategy_name    = cfg.getString("strategy",          strategy_name);
@@ -59,6 +401,14 @@ int main(int argc, char* argv[]) {
             take_profit_pct  = cfg.getDouble("take_profit_pct",   take_profit_pct);
             trailing_stop_pct= cfg.getDouble("trailing_stop_pct", trailing_stop_pct);
             slippage_bps     = cfg.getDouble("slippage_bps",      slippage_bps);
+            threads          = cfg.getInt("threads",              threads);
+            stream           = cfg.getBool("stream",              stream);
+            if (cfg.has("scheduler") && !parseScheduler(cfg.getString("scheduler"), scheduler)) return 1;
+            if (!cfg.getBool("tick_cache", true)) cache_mode = TickCacheMode::Off;
+            for (const char* key : {"from", "to", "session"}) {
+                std::string value = cfg.getString(key, "");
+                if (!value.empty() && !applyFilterOption(std::string("--") + key, value, filter)) return 1;
+            }
             std::cout << "Loaded config from: " << config_file << "\n";
         } catch (const std::exception& e) {
             std::cerr << "[WARN] Could not load config: " << e.what() << "\n";
@@ -73,8 +423,11 @@ int main(int argc, char* argv[]) {
             ++i; // already processed above
         } else if (std::strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
             csv_file = argv[++i];
+        } else if (std::strcmp(argv[i], "--dataset") == 0 && i + 1 < argc) {
+            dataset_dir = argv[++i];
         } else if (std::strcmp(argv[i], "--symbol") == 0 && i + 1 < argc) {
             symbol = argv[++i];
+            symbol_given = true;
         } else if (std::strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
             latency_ms = std::stod(argv[++i]);
         } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
@@ -89,10 +442,23 @@ int main(int argc, char* argv[]) {
             slippage_bps = std::stod(argv[++i]);
         } else if (std::strcmp(argv[i], "--strategy") == 0 && i + 1 < argc) {
             strategy_name = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::stoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--scheduler") == 0 && i + 1 < argc) {
+            if (!parseScheduler(argv[++i], scheduler)) return 1;
+        } else if (isFilterOption(argv[i]) && i + 1 < argc) {
+            if (!applyFilterOption(argv[i], argv[i + 1], filter)) return 1;
+            ++i;
         } else if (std::strcmp(argv[i], "--json-output") == 0 && i + 1 < argc) {
             json_output_file = argv[++i];
         } else if (std::strcmp(argv[i], "--dry-run") == 0) {
             dry_run = true;
+        } else if (std::strcmp(argv[i], "--stream") == 0) {
+            stream = true;
+        } else if (std::strcmp(argv[i], "--no-cache") == 0) {
+            cache_mode = TickCacheMode::Off;
+        } else if (std::strcmp(argv[i], "--rebuild-cache") == 0) {
+            cache_mode = TickCacheMode::Rebuild;
         } else {
             // Legacy positional argument support
             if (i == 1) csv_file = argv[i];
@@ -106,57 +472,69 @@ int main(int argc, char* argv[]) {
               << ALGOCATALYST_VERSION_PATCH << "\n"
               << "Event-Driven Backtesting for News Catalyst Strategies\n\n";
 
+    std::vector<std::string> csv_files, symbols;
+    DatasetPtr dataset;
+    if (!dataset_dir.empty()) {
+        dataset = Dataset::open(dataset_dir);
+        if (!dataset) return 1;
+        symbols = symbol_given ? splitList(symbol) : dataset->symbols();
+        if (symbols.empty()) {
+            std::cerr << "Error: Dataset " << dataset_dir << " has no partitions\n";
+            return 1;
+        }
+    } else if (!splitDataAndSymbols(csv_file, symbol, csv_files, symbols)) {
+        return 1;
+    }
+
+    TickStore::global().setCacheMode(cache_mode);
     Backtester backtester(latency_ms);
     backtester.setSlippageBps(slippage_bps);
+    backtester.setThreads(threads > 0 ? static_cast<unsigned>(threads) : 1u);
+    backtester.setScheduler(scheduler);
 
-    std::cout << "Loading tick data from: " << csv_file << "\n";
-    if (!backtester.loadTickData(csv_file, symbol)) {
-        std::cerr << "Error: Failed to load tick data from " << csv_file << "\n"
-                  << "Please ensure the CSV file exists with format:\n"
-                  << "Timestamp,Price,Volume,Bid_Size,Ask_Size\n";
-        return 1;
+    if (dataset) {
+        std::cout << "Using dataset " << dataset_dir << " for " << symbols.size() << " symbol(s)\n";
+        for (const auto& sym : symbols) {
+            if (!backtester.addDataset(sym, dataset, filter)) return 1;
+        }
+    }
+    for (std::size_t k = 0; !dataset && k < csv_files.size(); ++k) {
+        std::cout << "Loading tick data from: " << csv_files[k] << "\n";
+        bool loaded = stream ? backtester.streamTickData(csv_files[k], symbols[k], filter)
+                             : backtester.loadTickData(csv_files[k], symbols[k], filter);
+        if (!loaded) {
+            std::cerr << "Error: Failed to load tick data from " << csv_files[k] << "\n"
+                      << "Please ensure the CSV file exists with format:\n"
+                      << "Timestamp,Price,Volume,Bid_Size,Ask_Size\n";
+            return 1;
+        }
     }
 
-    RegimeClassifier regime_classifier(100, 2);
-
-    std::unique_ptr<Strategy> strategy;
-    if (strategy_name == "breakout") {
-        auto s = std::make_unique<BreakoutStrategy>(symbol, &regime_classifier);
-        s->setBasePositionSize(100.0);
-        s->setStopLossPercent(stop_loss_pct);
-        s->setTakeProfitPercent(take_profit_pct);
-        s->setTrailingStopPercent(trailing_stop_pct);
-        strategy = std::move(s);
-    } else if (strategy_name == "meanrev") {
-        auto s = std::make_unique<MeanReversionStrategy>(symbol, &regime_classifier);
-        s->setBasePositionSize(100.0);
-        s->setStopLossPercent(stop_loss_pct);
-        s->setTakeProfitPercent(take_profit_pct);
-        strategy = std::move(s);
-    } else {
-        auto s = std::make_unique<NewsMomentumStrategy>(symbol, &regime_classifier);
-        s->setMinRelativeVolume(5.0);
-        s->setMinGapUpPercent(10.0);
-        s->setMinBidAskRatio(1.5);
-        s->setBasePositionSize(100.0);
-        s->setStopLossPercent(stop_loss_pct);
-        s->setTakeProfitPercent(take_profit_pct);
-        s->setTrailingStopPercent(trailing_stop_pct);
-        strategy = std::move(s);
-    }
-
-    backtester.registerStrategy(symbol, std::move(strategy));
+    // One classifier per symbol so each symbol's regime (and a sharded run) is independent
+    std::vector<std::unique_ptr<RegimeClassifier>> regime_classifiers;
+
+    for (const auto& sym : symbols) {
+        regime_classifiers.push_back(std::make_unique<RegimeClassifier>(100, 2));
+        RegimeClassifier* regime_classifier = regime_classifiers.back().get();
+
+        StrategyParams params;
+        params.stop_loss_pct = stop_loss_pct;
+        params.take_profit_pct = take_profit_pct;
+        params.trailing_stop_pct = trailing_stop_pct;
+        backtester.registerStrategy(sym, makeStrategy(strategy_name, sym, regime_classifier, params));
+    }
 
     if (dry_run) {
         std::cout << "\n[DRY RUN] Configuration summary:\n"
-                  << "  Data:          " << csv_file << "\n"
-                  << "  Symbol:        " << symbol << "\n"
+                  << "  Data:          " << (dataset ? dataset_dir : csv_file) << "\n"
+                  << "  Symbol:        " << (dataset && !symbol_given ? "all (" + std::to_string(symbols.size()) + ")" : symbol) << "\n"
                   << "  Strategy:      " << strategy_name << "\n"
                   << "  Latency (ms):  " << latency_ms << "\n"
                   << "  Stop Loss:     " << stop_loss_pct << "%\n"
                   << "  Take Profit:   " << take_profit_pct << "%\n"
                   << "  Trailing Stop: " << trailing_stop_pct << "%\n"
                   << "  Slippage:      " << slippage_bps << " bps\n"
+                  << "  Threads:       " << backtester.getThreads() << "\n"
                   << "  Output:        " << output_file << "\n"
                   << "\n[DRY RUN] Exiting without running backtest.\n";
         return 0;
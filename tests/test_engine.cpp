@@ -1,5 +1,32 @@
 #include "runner.h"
 #include "Engine.h"
+#include "EventStore.h"
+#include "Strategy.h"
+#include "StreamingTickReader.h"
+#include "AI_Regime.h"
+#include "Dataset.h"
+#include "TickBlocks.h"
+#include "TickCache.h"
+#include "TickFile.h"
+#include "TickStore.h"
+#include "Timestamp.h"
+#include "Sweep.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/stat.h>
 
 using namespace AlgoCatalyst;
 using namespace TestRunner;
@@ -9,6 +36,105 @@ TEST(tick_loader_returns_empty_on_missing_file) {
     check(ticks.empty(), "TickLoader returns empty on missing file");
 }
 
+TEST(tick_loader_parses_rows_in_place) {
+    const std::string path = "/tmp/algocatalyst_loader_test.csv";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "Timestamp,Price,Volume,Bid_Size,Ask_Size\r\n"
+            << "1609459200000000,100.5,100,10,12\r\n"
+            << "# comment\r\n"
+            << "\r\n"
+            << "1609459201000000, 101.25,+200,11,13,102,99.5\r\n"
+            << "1609459202000000,abc,100,10,10\r\n"         // bad price
+            << "1609459203000000,100,100,10\r\n"            // too few columns
+            << "1609459204000000,-5,100,10,10\r\n"          // invalid price
+            << "1609459205000000,0x10,7,1,1";                  // hex float, no final newline
+    }
+    auto ticks = TickLoader::loadFromCSV(path);
+    std::remove(path.c_str());
+
+    check(ticks.size() == 3, "malformed, comment and blank CRLF rows skipped");
+    if (ticks.size() != 3) return;
+    check(ticks[0].timestamp_us == 1'609'459'200'000'000LL && ticks[0].price == 100.5, "first row");
+    check(ticks[0].ask_size == 12.0 && ticks[0].high == 100.5 && ticks[0].low == 100.5, "high/low default to price");
+    check(ticks[1].price == 101.25 && ticks[1].volume == 200, "leading space and '+' accepted");
+    check(ticks[1].high == 102.0 && ticks[1].low == 99.5, "optional high/low columns");
+    check(ticks[2].price == 16.0 && ticks[2].volume == 7, "hex float and unterminated last line");
+}
+
+TEST(tick_loader_parallel_chunks_match_serial) {
+    const std::string path = "/tmp/algocatalyst_chunk_test.csv";
+    {
+        std::ofstream out(path);
+        out << "Timestamp,Price,Volume,Bid_Size,Ask_Size\n";
+        std::int64_t ts = 1'609'459'200'000'000LL;
+        for (int i = 0; i < 5000; ++i) {
+            if (i % 397 == 0) out << ts << ",bad,1,1,1\n";
+            if (i % 211 == 0) ts -= 5'000'000;     // Out-of-order tick
+            ts += (i < 2500) ? 1'000'000 : -1'000'000;   // Second half runs backwards across chunk starts
+            out << ts << "," << 100 + (i % 13) * 0.25 << "," << i << ",10,10\n";
+        }
+    }
+
+    auto loadCapturing = [&](unsigned threads, std::string& log) {
+        TickLoadOptions options;
+        options.threads = threads;
+        options.min_chunk_bytes = 1024;   // Force many chunks on a small file
+        std::ostringstream captured;
+        std::streambuf* old = std::cerr.rdbuf(captured.rdbuf());
+        auto ticks = TickLoader::loadFromCSV(path, options);
+        std::cerr.rdbuf(old);
+        log = captured.str();
+        return ticks;
+    };
+
+    std::string serial_log, parallel_log;
+    auto serial = loadCapturing(1, serial_log);
+    auto parallel = loadCapturing(7, parallel_log);
+    std::remove(path.c_str());
+
+    bool same = serial.size() == 5000 && serial.size() == parallel.size();
+    for (std::size_t i = 0; same && i < serial.size(); ++i) {
+        same = serial[i].timestamp_us == parallel[i].timestamp_us && serial[i].price == parallel[i].price &&
+               serial[i].volume == parallel[i].volume;
+    }
+    check(same, "chunked parse yields the same ticks in the same order");
+    check(!serial_log.empty() && serial_log == parallel_log, "same warnings, line numbers and skip count");
+}
+
+TEST(tick_loader_parses_iso_timestamps) {
+    check(TickLoader::parseTimestamp("1609459200000000") == 1'609'459'200'000'000LL, "integer microseconds");
+    check(TickLoader::parseTimestamp("2021-01-01T00:00:00.5Z") - TickLoader::parseTimestamp("2021-01-01 00:00:00") == 500'000,
+          "fractional seconds");
+    check(TickLoader::parseTimestamp("garbage") == 0, "unparseable timestamp is 0");
+}
+
+TEST(timestamp_parser_is_utc_and_strict) {
+    check(daysFromCivil(1970, 1, 1) == 0 && daysFromCivil(2000, 3, 1) == 11017 && daysFromCivil(1969, 12, 31) == -1,
+          "days from civil");
+    TimestampParser parser;
+    check(parser.parse("2021-01-01T00:00:00Z") == 1'609'459'200'000'000LL, "epoch of 2021-01-01 UTC");
+    check(parser.parse("2024-02-29 23:59:59.1234569") == 1'709'251'199'123'456LL, "leap day, fraction truncated");
+    check(parser.parse("2024-03-01T00:00:00") == 1'709'251'200'000'000LL, "cached day is replaced on a new date");
+    check(parser.parse("2024-03-01T09:30:00-05:00") == parser.parse("2024-03-01T14:30:00Z") &&
+          parser.parse("2024-03-01T15:30:00+0100") == parser.parse("2024-03-01T14:30:00Z"), "UTC offsets");
+    for (const char* bad : {"2023-02-29T00:00:00", "2024-13-01T00:00:00", "2024-01-01T24:00:00",
+                            "2024-01-01T00:00:00.", "2024-01-01T00:00:00 junk", "2024-01-01", "2024-1-01T00:00:00"}) {
+        check(parser.parse(bad) == 0, std::string("rejects ") + bad);
+    }
+
+    // Independent of the process time zone (mktime was not)
+    const char* old_tz = std::getenv("TZ");
+    std::string saved = old_tz ? old_tz : "";
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+    std::int64_t in_new_york = TickLoader::parseTimestamp("2021-01-01T00:00:00");
+    if (old_tz) setenv("TZ", saved.c_str(), 1);
+    else unsetenv("TZ");
+    tzset();
+    check(in_new_york == 1'609'459'200'000'000LL, "TZ does not change the result");
+}
+
 TEST(backtester_starts_with_zero_trades) {
     Backtester bt(200.0);
     check(bt.getNumTrades() == 0, "Zero trades before run");
@@ -58,3 +184,1131 @@ TEST(backtester_commission_free_mode) {
     bt.setCommissionFree(true);
     check(!bt.isHaltedByRisk(), "Commission-free mode does not corrupt state");
 }
+
+// ── EventStore ────────────────────────────────────────────────────────────────
+static EventRecord makeOrderRecord(std::int64_t ts, double qty) {
+    EventRecord r{};
+    r.type = EventType::OrderEvent;
+    r.direction = SignalEvent::Direction::LONG;
+    r.timestamp_us = ts;
+    r.order = {qty, 100.0, 0.0};
+    return r;
+}
+
+TEST(event_store_pops_in_timestamp_order) {
+    EventStore store;
+    store.push(makeOrderRecord(300, 1.0));
+    store.push(makeOrderRecord(100, 2.0));
+    store.push(makeOrderRecord(200, 3.0));
+    check(store.pop().timestamp_us == 100, "earliest first");
+    check(store.pop().timestamp_us == 200, "then 200");
+    check(store.pop().timestamp_us == 300, "then 300");
+    check(store.empty(), "store drained");
+}
+
+TEST(event_store_ties_pop_in_insertion_order) {
+    EventStore store;
+    for (int i = 0; i < 100; ++i) store.push(makeOrderRecord(500, static_cast<double>(i)));
+    for (int i = 0; i < 100; ++i) {
+        checkClose(store.pop().order.quantity, static_cast<double>(i), 1e-12,
+                   "equal timestamps are FIFO");
+    }
+}
+
+TEST(event_store_steady_state_does_not_allocate) {
+    EventStore store;
+    store.reserve(64);
+    const std::size_t warm = store.stats().allocations;
+    std::int64_t ts = 0;
+    for (int i = 0; i < 100000; ++i) {
+        store.push(makeOrderRecord(ts + 10, 1.0));
+        store.push(makeOrderRecord(ts + 5, 1.0));
+        ts = store.pop().timestamp_us;
+        ts = store.pop().timestamp_us;
+    }
+    check(store.stats().allocations == warm, "no allocations after reserve");
+    check(store.stats().peak_live == 2, "peak live events tracked");
+}
+
+// ── Scheduler ─────────────────────────────────────────────────────────────────
+TEST(radix_heap_matches_binary_heap_on_monotone_workload) {
+    // Engine-like load: pop the earliest event, schedule follow-ups at or after it
+    BinaryHeapScheduler reference;
+    RadixHeapScheduler radix;
+    std::uint64_t seq = 0;
+    std::uint32_t rng = 12345;
+    auto next = [&rng] { rng = rng * 1664525u + 1013904223u; return rng >> 8; };
+
+    for (int i = 0; i < 64; ++i) {
+        ScheduledKey k{static_cast<std::int64_t>(next() % 1000), seq++, 0};
+        reference.push(k);
+        radix.push(k);
+    }
+    bool same = true;
+    for (int i = 0; i < 200000 && same; ++i) {
+        ScheduledKey a = reference.pop();
+        ScheduledKey b = radix.pop();
+        same = a.timestamp_us == b.timestamp_us && a.seq == b.seq;
+        int follow_ups = static_cast<int>(next() % 3);   // queue size drifts around 64
+        for (int j = 0; j < follow_ups; ++j) {
+            // Zero delay (ties) is common; occasionally jump far ahead
+            std::int64_t delay = next() % 4 == 0 ? 0 : static_cast<std::int64_t>(next() % (j == 2 ? 5'000'000 : 300));
+            ScheduledKey k{a.timestamp_us + delay, seq++, 0};
+            reference.push(k);
+            radix.push(k);
+        }
+        if (reference.empty()) break;
+        same = same && reference.top().seq == radix.top().seq;
+    }
+    check(same, "radix heap pops the same (timestamp, seq) sequence as the binary heap");
+}
+
+TEST(radix_heap_rejects_events_before_last_pop) {
+    RadixHeapScheduler radix;
+    radix.push({100, 0, 0});
+    radix.push({200, 1, 0});
+    radix.pop();
+    bool threw = false;
+    try {
+        radix.push({50, 2, 0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    check(threw, "non-monotone push rejected");
+    check(radix.size() == 1 && radix.top().timestamp_us == 200, "queue unchanged by rejected push");
+}
+
+TEST(event_store_radix_steady_state_does_not_allocate) {
+    EventStore store(SchedulerKind::RadixHeap);
+    store.reserve(64);
+    const std::size_t warm = store.stats().allocations;
+    std::int64_t ts = 0;
+    for (int i = 0; i < 100000; ++i) {
+        store.push(makeOrderRecord(ts + 10, 1.0));
+        store.push(makeOrderRecord(ts + 5, 1.0));
+        ts = store.pop().timestamp_us;
+        ts = store.pop().timestamp_us;
+    }
+    check(ts == 100000 * 10, "events popped in time order");
+    check(store.stats().allocations == warm, "no allocations after reserve");
+}
+
+TEST(event_store_radix_falls_back_on_backward_push) {
+    EventStore store(SchedulerKind::RadixHeap);
+    store.push(makeOrderRecord(100, 1.0));
+    store.push(makeOrderRecord(300, 2.0));
+    store.push(makeOrderRecord(300, 3.0));
+    store.pop();
+    store.push(makeOrderRecord(50, 4.0));
+    check(store.schedulerKind() == SchedulerKind::BinaryHeap && store.stats().fallbacks == 1,
+          "backward push moves the queue to a binary heap");
+    std::vector<double> order;
+    while (!store.empty()) order.push_back(store.pop().order.quantity);
+    check(order == std::vector<double>{4.0, 2.0, 3.0}, "queued events keep time and FIFO order");
+}
+
+// ── Tick stream merge ─────────────────────────────────────────────────────────
+namespace {
+
+// Records every tick routed to it; never trades
+class RecordingStrategy : public Strategy {
+public:
+    explicit RecordingStrategy(const std::string& symbol) : Strategy(symbol) {}
+
+    void onMarketUpdate(const Tick& tick, SignalEmitter&) override {
+        seen.push_back(tick.timestamp_us);
+    }
+
+    std::vector<std::int64_t> seen;
+};
+
+std::vector<Tick> makeSeries(std::int64_t start_us, std::int64_t step_us, int n) {
+    std::vector<Tick> ticks;
+    for (int i = 0; i < n; ++i) {
+        Tick t{};
+        t.timestamp_us = start_us + i * step_us;
+        t.price = 100.0 + i;
+        t.volume = 100;
+        t.high = t.low = t.price;
+        ticks.push_back(t);
+    }
+    return ticks;
+}
+
+} // namespace
+
+TEST(backtester_merges_tick_streams_per_symbol) {
+    auto a = makeSeries(1'000'000, 2'000'000, 50);   // odd seconds
+    auto b = makeSeries(2'000'000, 2'000'000, 50);   // even seconds, overlapping range
+
+    Backtester bt(0.0);
+    auto strat_a = std::make_unique<RecordingStrategy>("AAA");
+    auto strat_b = std::make_unique<RecordingStrategy>("BBB");
+    RecordingStrategy* ra = strat_a.get();
+    RecordingStrategy* rb = strat_b.get();
+    bt.registerStrategy("AAA", std::move(strat_a));
+    bt.registerStrategy("BBB", std::move(strat_b));
+    bt.addTickSource("AAA", std::make_unique<VectorTickSource>(a));
+    bt.addTickSource("BBB", std::make_unique<VectorTickSource>(b));
+    bt.run();
+
+    check(ra->seen.size() == a.size(), "AAA receives only its own ticks");
+    check(rb->seen.size() == b.size(), "BBB receives only its own ticks");
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        check(ra->seen[i] == a[i].timestamp_us, "AAA ticks in order");
+        check(rb->seen[i] == b[i].timestamp_us, "BBB ticks in order");
+    }
+    check(bt.getEventStoreStats().pushed == 0, "ticks never enter the scheduling queue");
+}
+
+// ── Incremental risk state ────────────────────────────────────────────────────
+namespace {
+
+// Buys 10 shares on even ticks and exits on odd ticks at the tick price
+class RoundTripStrategy : public Strategy {
+public:
+    explicit RoundTripStrategy(const std::string& symbol) : Strategy(symbol) {}
+
+    void onMarketUpdate(const Tick& tick, SignalEmitter& out) override {
+        auto dir = (seen++ % 2 == 0) ? SignalEvent::Direction::LONG : SignalEvent::Direction::EXIT;
+        out.emit(tick.timestamp_us, symbol_id_, dir, 10.0, tick.price);
+    }
+
+    int seen = 0;
+};
+
+// Each round trip buys at 100 and sells at 99: a $10 loss per trade
+std::vector<Tick> makeLosingDay(std::int64_t day, int round_trips) {
+    constexpr std::int64_t US_PER_DAY = 86400LL * 1'000'000LL;
+    std::vector<Tick> ticks;
+    for (int i = 0; i < round_trips * 2; ++i) {
+        Tick t{};
+        t.timestamp_us = day * US_PER_DAY + (i + 1) * 60'000'000LL;
+        t.price = (i % 2 == 0) ? 100.0 : 99.0;
+        t.volume = 100;
+        t.high = t.low = t.price;
+        ticks.push_back(t);
+    }
+    return ticks;
+}
+
+} // namespace
+
+TEST(backtester_risk_state_tracks_equity_incrementally) {
+    auto ticks = makeLosingDay(20000, 3);
+
+    Backtester bt(0.0);
+    bt.setCommissionFree(true);
+    bt.setSlippageBps(0.0);
+    bt.registerStrategy("RSK1", std::make_unique<RoundTripStrategy>("RSK1"));
+    bt.addTickSource("RSK1", std::make_unique<VectorTickSource>(ticks));
+    bt.run();
+
+    const RiskState& risk = bt.getRiskState();
+    check(risk.num_trades == 3 && bt.getNumTrades() == 3, "one trade per round trip");
+    checkClose(risk.realized_equity, -30.0, 1e-9, "realized equity is the sum of trade PnL");
+    checkClose(bt.getTotalPnL(), risk.realized_equity, 1e-12, "getTotalPnL reads the running total");
+    checkClose(bt.getMaxDrawdown(), 30.0, 1e-9, "drawdown measured from the zero high-water mark");
+    checkClose(risk.daily_pnl, -30.0, 1e-9, "all losses fall on one day");
+    check(risk.consec_losses == 3, "loss streak counted");
+    check(risk.current_day == 20000, "UTC day index tracked");
+    checkClose(bt.getWinRate(), 0.0, 1e-9, "no winners");
+}
+
+TEST(backtester_daily_loss_halt_lifts_on_next_day) {
+    auto ticks = makeLosingDay(20000, 3);
+    auto day2 = makeLosingDay(20001, 3);
+    ticks.insert(ticks.end(), day2.begin(), day2.end());
+
+    Backtester bt(0.0);
+    bt.setCommissionFree(true);
+    bt.setSlippageBps(0.0);
+    bt.setMaxDailyLoss(15.0);
+    auto strat = std::make_unique<RoundTripStrategy>("RSK2");
+    RoundTripStrategy* rt = strat.get();
+    bt.registerStrategy("RSK2", std::move(strat));
+    bt.addTickSource("RSK2", std::make_unique<VectorTickSource>(ticks));
+    bt.run();
+
+    const RiskState& risk = bt.getRiskState();
+    check(risk.num_trades == 4, "two losing trades per day before the halt");
+    check(rt->seen == 8, "strategy skipped while halted, resumed the next day");
+    checkClose(risk.daily_pnl, -20.0, 1e-9, "daily PnL reset at the day boundary");
+    check(risk.halted_daily_loss && bt.isHaltedByRisk(), "second day halts again");
+    check(!risk.halted_drawdown && !risk.halted_consec, "other breakers untouched");
+}
+
+// ── Signal emitter ────────────────────────────────────────────────────────────
+TEST(signal_emitter_reuses_storage_across_ticks) {
+    RoundTripStrategy strat("EMT1");
+    SignalEmitter out;
+    auto ticks = makeSeries(1'000'000, 1'000'000, 1000);
+    out.clear();
+    strat.onMarketUpdate(ticks[0], out);
+    const std::size_t cap = out.capacity();
+    const Signal* storage = &out[0];
+    bool stable = true;
+    for (std::size_t i = 1; i < ticks.size(); ++i) {
+        out.clear();
+        strat.onMarketUpdate(ticks[i], out);
+        stable = stable && out.size() == 1 && out.capacity() == cap && &out[0] == storage;
+    }
+    check(stable, "emitter storage reused with no regrowth");
+}
+
+TEST(strategy_vector_wrapper_matches_emitter) {
+    RoundTripStrategy strat("EMT2");
+    auto ticks = makeSeries(5'000'000, 1'000'000, 2);
+    auto events = strat.processMarketUpdate(MarketUpdateEvent(ticks[1].timestamp_us, ticks[1]));
+    check(events.size() == 1, "one signal converted");
+    const auto& sig = static_cast<const SignalEvent&>(*events[0]);
+    check(sig.getDirection() == SignalEvent::Direction::LONG, "direction preserved");
+    check(sig.getSymbolId() == strat.getSymbolId(), "symbol preserved");
+    check(sig.getTimestamp() == ticks[1].timestamp_us, "timestamp preserved");
+    checkClose(sig.getPrice(), ticks[1].price, 1e-12, "price preserved");
+}
+
+// ── Sharded multi-symbol runs ─────────────────────────────────────────────────
+namespace {
+
+// Same trades in the same order, bit for bit
+bool sameTrades(const std::vector<TradeRecord>& a, const std::vector<TradeRecord>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].symbol_id != b[i].symbol_id || a[i].entry_timestamp_us != b[i].entry_timestamp_us ||
+            a[i].exit_timestamp_us != b[i].exit_timestamp_us || a[i].entry_price != b[i].entry_price ||
+            a[i].exit_price != b[i].exit_price || a[i].quantity != b[i].quantity || a[i].pnl != b[i].pnl ||
+            a[i].mae != b[i].mae || a[i].mfe != b[i].mfe) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Run 'n_symbols' round-trip symbols on 'threads' workers; symbols share exit
+// timestamps so the merge has cross-symbol ties to order
+std::vector<TradeRecord> runRoundTrips(int n_symbols, unsigned threads, double* total_pnl) {
+    std::vector<std::vector<Tick>> series;
+    for (int k = 0; k < n_symbols; ++k) {
+        auto ticks = makeSeries(1'000'000, 1'000'000, 40 + k);
+        for (std::size_t i = 0; i < ticks.size(); ++i) {
+            ticks[i].price = 100.0 + 0.1 * k + ((i * (k + 3)) % 7) * 0.37;
+        }
+        series.push_back(std::move(ticks));
+    }
+
+    Backtester bt(0.0);
+    bt.setVerbose(false);
+    bt.setThreads(threads);
+    for (int k = 0; k < n_symbols; ++k) {
+        std::string sym = "SHD" + std::to_string(k);
+        bt.registerStrategy(sym, std::make_unique<RoundTripStrategy>(sym));
+        bt.addTickSource(sym, std::make_unique<VectorTickSource>(series[k]));
+    }
+    bt.run();
+    *total_pnl = bt.getTotalPnL();
+    return bt.getTradeLog();
+}
+
+} // namespace
+
+TEST(backtester_sharded_run_matches_single_threaded) {
+    double serial_pnl = 0.0, sharded_pnl = 0.0;
+    auto serial = runRoundTrips(9, 1, &serial_pnl);
+    auto sharded = runRoundTrips(9, 4, &sharded_pnl);
+
+    check(!serial.empty() && serial.size() == sharded.size(), "same number of trades");
+    check(sameTrades(serial, sharded), "trade logs identical and identically ordered");
+    check(serial_pnl == sharded_pnl, "total PnL bit-identical");
+}
+
+TEST(backtester_default_scheduler_accepts_backward_timestamps) {
+    // The loader keeps out-of-order rows with a warning: a tick that steps back
+    // in time emits a signal while the previous tick's fill is still queued
+    auto ticks = makeSeries(1'000'000, 1'000'000, 40);
+    for (std::size_t i = 20; i < ticks.size(); ++i) ticks[i].timestamp_us -= 30'000'000;
+
+    auto runWith = [&](SchedulerKind kind, std::span<const Tick> series, SchedulerKind* active) {
+        Backtester bt(5000.0);
+        bt.setVerbose(false);
+        bt.setScheduler(kind);
+        bt.registerStrategy("BWD1", std::make_unique<RoundTripStrategy>("BWD1"));
+        bt.addTickSource("BWD1", std::make_unique<VectorTickSource>(series));
+        bt.run();
+        *active = bt.getActiveScheduler();
+        return bt.getTradeLog();
+    };
+    SchedulerKind active{};
+    auto by_auto = runWith(SchedulerKind::Auto, ticks, &active);
+    check(active == SchedulerKind::BinaryHeap && !by_auto.empty(), "auto runs unsorted ticks on the binary heap");
+    auto by_radix = runWith(SchedulerKind::RadixHeap, ticks, &active);
+    check(active == SchedulerKind::BinaryHeap && sameTrades(by_radix, by_auto),
+          "radix heap falls back mid-run with the same trades");
+
+    auto sorted = makeSeries(1'000'000, 1'000'000, 40);
+    auto sorted_auto = runWith(SchedulerKind::Auto, sorted, &active);
+    check(active == SchedulerKind::RadixHeap, "auto picks the radix heap for sorted ticks");
+    check(sameTrades(sorted_auto, runWith(SchedulerKind::BinaryHeap, sorted, &active)), "same trades on either heap");
+}
+
+TEST(backtester_portfolio_limits_force_single_thread) {
+    auto ticks_a = makeLosingDay(20000, 3);
+    auto ticks_b = makeLosingDay(20000, 3);
+
+    Backtester bt(0.0);
+    bt.setVerbose(false);
+    bt.setCommissionFree(true);
+    bt.setSlippageBps(0.0);
+    bt.setThreads(2);
+    bt.setMaxConsecLosses(3);
+    bt.registerStrategy("LIM1", std::make_unique<RoundTripStrategy>("LIM1"));
+    bt.registerStrategy("LIM2", std::make_unique<RoundTripStrategy>("LIM2"));
+    bt.addTickSource("LIM1", std::make_unique<VectorTickSource>(ticks_a));
+    bt.addTickSource("LIM2", std::make_unique<VectorTickSource>(ticks_b));
+    bt.run();
+
+    check(bt.getRiskState().halted_consec, "breaker sees losses across both symbols");
+    check(bt.getNumTrades() < 6, "entries stop once the combined streak trips the halt");
+}
+
+// ── Shared tick store / reset ─────────────────────────────────────────────────
+namespace {
+
+// Oscillating series so mean-reversion entries fire repeatedly
+std::vector<Tick> makeWave(int n) {
+    std::vector<Tick> ticks;
+    for (int i = 0; i < n; ++i) {
+        Tick t{};
+        t.timestamp_us = 1'609'459'200'000'000LL + i * 1'000'000LL;
+        t.price = 100.0 + 3.0 * std::sin(i * 0.05) + 0.4 * std::sin(i * 0.9);
+        t.volume = 1000 + (i % 17) * 50;
+        t.bid_size = 500;
+        t.ask_size = 500;
+        t.high = t.low = t.price;
+        ticks.push_back(t);
+    }
+    return ticks;
+}
+
+// CSV rows for 'ticks', no header; bad rows can be written between calls
+void writeTickRows(std::ostream& out, std::span<const Tick> ticks, const char* eol = "\n") {
+    out << std::setprecision(17);
+    for (const Tick& t : ticks) {
+        out << t.timestamp_us << ',' << t.price << ',' << t.volume << ',' << t.bid_size << ',' << t.ask_size << eol;
+    }
+}
+
+void writeTickCsv(const std::string& path, std::span<const Tick> ticks) {
+    std::ofstream out(path);
+    out << "Timestamp,Price,Volume,Bid_Size,Ask_Size\n";
+    writeTickRows(out, ticks);
+}
+
+// Trades of a mean-reversion run on 'symbol' over whatever 'attach' adds;
+// with 'rerun' set, also checks that a reset and second run repeat them
+std::vector<TradeRecord> meanRevTrades(const std::string& symbol, const std::function<void(Backtester&)>& attach,
+                                       double latency_ms, bool rerun = false) {
+    RegimeClassifier regime(100, 2);
+    Backtester bt(latency_ms);
+    bt.setVerbose(false);
+    attach(bt);
+    bt.registerStrategy(symbol, std::make_unique<MeanReversionStrategy>(symbol, &regime));
+    bt.run();
+    auto trades = bt.getTradeLog();
+    if (rerun) {
+        bt.reset();
+        bt.run();
+        check(sameTrades(bt.getTradeLog(), trades), "rerun after reset");
+    }
+    return trades;
+}
+
+} // namespace
+
+TEST(tick_store_caches_and_shares_series) {
+    const std::string path = "/tmp/algocatalyst_tickstore_test.csv";
+    {
+        std::ofstream out(path);
+        out << "Timestamp,Price,Volume,Bid_Size,Ask_Size\n";
+        for (int i = 0; i < 10; ++i) {
+            out << 1'609'459'200'000'000LL + i * 1'000'000LL << "," << 100 + i << ",100,10,10\n";
+        }
+    }
+    TickStore& store = TickStore::global();
+    TickSeriesPtr a = store.load(path, "TSA");
+    TickSeriesPtr b = store.load(path, "TSA");
+    check(a && a->size() == 10, "file parsed");
+    check(a.get() == b.get(), "second load reuses the cached series");
+    check((*a)[0].symbol_id == internSymbol("TSA"), "ticks stamped with the symbol");
+
+    Backtester bt1(0.0), bt2(0.0);
+    bt1.setVerbose(false);
+    bt2.setVerbose(false);
+    check(bt1.loadTickData(path, "TSA") && bt2.loadTickData(path, "TSA"), "backtesters load from the store");
+    check(a.use_count() >= 4, "both backtesters hold the same series");
+
+    store.evict(path, "TSA");
+    check(store.load(path, "TSA").get() != a.get(), "evicted entry is re-parsed");
+    store.evict(path, "TSA");
+    std::remove(path.c_str());
+}
+
+TEST(backtester_reset_reproduces_run) {
+    TickSeriesPtr ticks = TickStore::adopt(makeWave(600), internSymbol("RST1"));
+    RegimeClassifier regime(100, 2);
+
+    Backtester bt(0.0);
+    bt.setVerbose(false);
+    bt.addTickSeries("RST1", ticks);
+    bt.registerStrategy("RST1", std::make_unique<MeanReversionStrategy>("RST1", &regime));
+    bt.run();
+    std::vector<TradeRecord> first = bt.getTradeLog();
+    double first_pnl = bt.getTotalPnL();
+
+    check(bt.reset(), "vector-backed sources rewind");
+    check(bt.getNumTrades() == 0 && bt.getTotalPnL() == 0.0, "reset clears trades and equity");
+    bt.run();
+    const auto& second = bt.getTradeLog();
+
+    check(!first.empty() && first.size() == second.size(), "same number of trades after reset");
+    check(sameTrades(first, second), "rerun after reset is bit-identical");
+    check(bt.getTotalPnL() == first_pnl, "equity identical");
+}
+
+// ── ParameterSweep ────────────────────────────────────────────────────────────
+TEST(parameter_sweep_matches_standalone_runs) {
+    TickSeriesPtr ticks = TickStore::adopt(makeWave(600), internSymbol("SWP1"));
+
+    SweepGrid grid;
+    grid.stop_loss_pct = {1.0, 2.0};
+    grid.take_profit_pct = {1.5, 4.0};
+    grid.trailing_stop_pct = {1.0, 3.0};
+    grid.slippage_bps = {0.0, 5.0};
+
+    ParameterSweep sweep("meanrev", 0.0);
+    sweep.setGrid(grid);
+    sweep.addSeries("SWP1", ticks);
+    check(sweep.combinations().size() == 12, "take-profit <= stop-loss combinations skipped");
+
+    sweep.setThreads(1);
+    auto serial = sweep.run();
+    sweep.setThreads(3);
+    auto pooled = sweep.run();
+
+    bool identical = serial.size() == pooled.size();
+    for (std::size_t i = 0; identical && i < serial.size(); ++i) {
+        identical = serial[i].num_trades == pooled[i].num_trades &&
+                    serial[i].total_pnl == pooled[i].total_pnl &&
+                    serial[i].sharpe_ratio == pooled[i].sharpe_ratio;
+    }
+    check(identical, "results identical and in grid order for any thread count");
+
+    // Spot-check one grid point against a fresh standalone backtest
+    const SweepResult& r = serial.back();
+    RegimeClassifier regime(100, 2);
+    Backtester bt(0.0);
+    bt.setVerbose(false);
+    bt.setSlippageBps(r.combo.slippage_bps);
+    bt.addTickSeries("SWP1", ticks);
+    bt.registerStrategy("SWP1", makeStrategy("meanrev", "SWP1", &regime, r.combo.params));
+    bt.run();
+    check(r.num_trades > 0 && r.num_trades == bt.getNumTrades(), "same trade count");
+    check(r.total_pnl == bt.getTotalPnL(), "same PnL as a standalone run");
+}
+
+// ── Columnar tick files ───────────────────────────────────────────────────────
+TEST(tick_file_round_trips_columns_and_symbols) {
+    const std::string path = "/tmp/algocatalyst_tickfile_test.actk";
+    auto a = makeWave(300);
+    auto b = makeSeries(1'609'459'200'500'000LL, 2'000'000, 50);
+    check(ColumnarTickFile::write(path, {{"TFA", a}, {"LONGER_NAME_B", b}}), "file written");
+    check(ColumnarTickFile::isTickFile(path), "magic detected");
+
+    TickFilePtr file = ColumnarTickFile::open(path);
+    check(file && file->rows() == 350 && file->symbols().size() == 2, "header and symbol table");
+    if (!file) return;
+    const auto* range = file->findSymbol("LONGER_NAME_B");
+    check(range && range->first_row == 300 && range->row_count == 50, "symbol range");
+    check(file->timestamps()[0] == a[0].timestamp_us && file->prices()[299] == a[299].price, "columns match");
+    check(reinterpret_cast<std::uintptr_t>(file->prices().data()) % 64 == 0, "columns 64-byte aligned");
+
+    {
+        std::ofstream corrupt(path, std::ios::binary | std::ios::in | std::ios::out);
+        corrupt.seekp(16);   // row_count
+        std::uint64_t rows = 1ull << 40;
+        corrupt.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    }
+    std::ostringstream captured;
+    std::streambuf* old = std::cerr.rdbuf(captured.rdbuf());
+    bool rejected = !ColumnarTickFile::open(path);
+    std::cerr.rdbuf(old);
+    check(rejected, "corrupt header rejected");
+    std::remove(path.c_str());
+}
+
+TEST(tick_file_convert_sorts_out_of_order_csv) {
+    const std::string csv = "/tmp/algocatalyst_unsorted_test.csv";
+    const std::string path = "/tmp/algocatalyst_unsorted_test.actk";
+    std::remove(path.c_str());
+    // Minute ticks with every tenth row stamped 30 minutes early
+    const std::int64_t start = 1'609'459'200'000'000LL;
+    {
+        std::ofstream out(csv);
+        out << "Timestamp,Price,Volume,Bid_Size,Ask_Size\n";
+        for (int i = 0; i < 200; ++i) {
+            std::int64_t ts = start + i * 60'000'000LL - (i % 10 == 9 ? 1'800'000'000LL : 0);
+            out << ts << ',' << 100 + i << ",100,10,10\n";
+        }
+    }
+    std::ostringstream captured;
+    std::streambuf* old = std::cerr.rdbuf(captured.rdbuf());
+    auto ticks = TickLoader::loadFromCSV(csv);
+    bool rejected = !ColumnarTickFile::write(path, {{"UNS", ticks}});
+    std::cerr.rdbuf(old);
+    check(ticks.size() == 200, "loader keeps out-of-order rows");
+    check(rejected && !std::ifstream(path).good(), "unsorted series rejected before the file is created");
+
+    check(sortByTimestamp(ticks) == 20, "out-of-order rows counted");
+    check(ColumnarTickFile::write(path, {{"UNS", ticks}}), "sorted series written");
+    TickFilePtr file = ColumnarTickFile::open(path);
+    check(file != nullptr, "file opens");
+    if (!file) return;
+
+    TickFilter filter;
+    filter.start_us = start + 40 * 60'000'000LL;
+    filter.end_us = start + 120 * 60'000'000LL;
+    std::size_t expected = std::count_if(ticks.begin(), ticks.end(),
+                                         [&](const Tick& t) { return filter.contains(t.timestamp_us); });
+    std::size_t selected = 0;
+    for (const RowRange& r : file->selectRows(file->symbols()[0], filter)) {
+        for (std::uint64_t row = r.begin; row < r.end; ++row) {
+            check(filter.contains(file->timestamps()[row]), "selected row passes the filter");
+            ++selected;
+        }
+    }
+    check(selected == expected && expected == 80, "window selects every passing row");
+    std::remove(csv.c_str());
+    std::remove(path.c_str());
+}
+
+TEST(backtester_tick_file_matches_in_memory_series) {
+    const std::string path = "/tmp/algocatalyst_tickfile_bt.actk";
+    auto ticks = makeWave(600);
+    check(ColumnarTickFile::write(path, {{"TFB", ticks}}), "file written");
+
+    auto from_memory = meanRevTrades("TFB", [&](Backtester& bt) {
+        bt.addTickSeries("TFB", TickStore::adopt(ticks, internSymbol("TFB")));
+    }, 0.0);
+    auto from_file = meanRevTrades("TFB", [&](Backtester& bt) { bt.loadTickData(path, "TFB"); }, 0.0);
+    std::remove(path.c_str());
+
+    check(!from_memory.empty() && sameTrades(from_memory, from_file),
+          "mapped columns give the same trades as the tick vector");
+}
+
+TEST(tick_blocks_round_trip_bit_exact) {
+    const std::string path = "/tmp/algocatalyst_tickblocks_test.actz";
+    auto wave = makeWave(300);   // Prices with no short decimal form: stored raw
+    std::vector<Tick> quotes;
+    for (int i = 0; i < 500; ++i) {
+        Tick t{};
+        t.timestamp_us = 1'609'459'200'000'000LL + (i / 3) * 1'000'000LL;   // Runs of equal timestamps
+        t.price = 100.0 + (i % 41) * 0.01 - (i % 7) * 0.25;
+        t.volume = 100 * (1 + i % 9);
+        t.bid_size = 200 + i % 13;
+        t.ask_size = 0.5 * (i % 5);
+        t.high = t.price + 0.05;
+        t.low = t.price - 0.10;
+        quotes.push_back(t);
+    }
+    check(CompressedTickFile::write(path, {{"WAVE", wave}, {"QUOTES", quotes}}, 64), "file written");
+    check(CompressedTickFile::isCompressedFile(path) && !ColumnarTickFile::isTickFile(path), "magic detected");
+
+    CompressedTickFilePtr file = CompressedTickFile::open(path);
+    check(file && file->rows() == 800 && file->symbols().size() == 2, "header and symbol table");
+    if (!file) return;
+    check(file->bytes() < 800 * 7 * 8, "smaller than raw columns");
+    const auto* range = file->findSymbol("QUOTES");
+    check(range && range->row_count == 500 && range->block_count == 8, "symbol blocks");
+    if (!range) return;
+
+    auto same = [](const Tick& a, const Tick& b) {
+        return a.timestamp_us == b.timestamp_us && a.volume == b.volume &&
+               std::memcmp(&a.price, &b.price, sizeof(double)) == 0 &&
+               std::memcmp(&a.bid_size, &b.bid_size, sizeof(double)) == 0 &&
+               std::memcmp(&a.ask_size, &b.ask_size, sizeof(double)) == 0 &&
+               std::memcmp(&a.high, &b.high, sizeof(double)) == 0 &&
+               std::memcmp(&a.low, &b.low, sizeof(double)) == 0;
+    };
+    bool exact = true;
+    for (const auto& [name, ticks] : {std::pair{"WAVE", &wave}, std::pair{"QUOTES", &quotes}}) {
+        CompressedTickSource source(file, *file->findSymbol(name), 0);
+        std::size_t i = 0;
+        for (const Tick* t = source.peek(); t; source.advance(), t = source.peek(), ++i) {
+            exact = exact && i < ticks->size() && same(*t, (*ticks)[i]);
+        }
+        exact = exact && i == ticks->size();
+    }
+    check(exact, "every field decodes bit-exactly");
+
+    CompressedTickSource source(file, *range, 0);
+    source.seek(quotes[400].timestamp_us);
+    const Tick* at = source.peek();
+    check(at && same(*at, quotes[399]), "seek lands on the first tick of an equal-timestamp run");
+    source.advance();
+    const Tick* back = source.firstAtOrAfter(quotes[399].timestamp_us);
+    check(back && same(*back, quotes[399]), "firstAtOrAfter looks behind the cursor");
+    std::size_t boundary = 64 * 5;   // quotes[318..320] share a timestamp across blocks 4 and 5
+    source.seek(quotes[boundary].timestamp_us + 1);
+    back = source.firstAtOrAfter(quotes[boundary].timestamp_us);
+    check(back && same(*back, quotes[318]), "firstAtOrAfter reaches into the previous block");
+
+    const TickBlockInfo block = file->blocks()[range->first_block + 2];
+    {
+        std::ofstream corrupt(path, std::ios::binary | std::ios::in | std::ios::out);
+        corrupt.seekp(static_cast<std::streamoff>(block.offset));   // Timestamp column encoding tag
+        corrupt.put('\x7f');
+    }
+    file = CompressedTickFile::open(path);
+    std::vector<Tick> decoded;
+    std::ostringstream captured;
+    std::streambuf* old = std::cerr.rdbuf(captured.rdbuf());
+    bool rejected = file && !file->decodeBlock(range->first_block + 2, 0, decoded);
+    std::cerr.rdbuf(old);
+    check(rejected && decoded.empty(), "corrupt block rejected");
+    std::remove(path.c_str());
+}
+
+TEST(compressed_file_rejects_unsorted_series) {
+    const std::string path = "/tmp/algocatalyst_unsorted_test.actz";
+    std::remove(path.c_str());
+    auto ticks = makeSeries(1'609'459'200'000'000LL, 60'000'000, 300);
+    for (std::size_t i = 9; i < ticks.size(); i += 10) ticks[i].timestamp_us -= 1'800'000'000LL;
+
+    std::ostringstream captured;
+    std::streambuf* old = std::cerr.rdbuf(captured.rdbuf());
+    bool rejected = !CompressedTickFile::write(path, {{"UNZ", ticks}}, 16);
+    std::cerr.rdbuf(old);
+    check(rejected && !std::ifstream(path).good(), "unsorted series rejected before the file is created");
+
+    // Sorted, a filtered load seeks through the block index to exactly the passing rows
+    check(sortByTimestamp(ticks) == 30, "out-of-order rows counted");
+    check(CompressedTickFile::write(path, {{"UNZ", ticks}}, 16), "sorted series written");
+    TickFilter filter;
+    filter.start_us = ticks[100].timestamp_us;
+    filter.end_us = ticks[200].timestamp_us;
+    Backtester bt(0.0);
+    bt.setVerbose(false);
+    auto strat = std::make_unique<RecordingStrategy>("UNZ");
+    RecordingStrategy* seen = strat.get();
+    bt.registerStrategy("UNZ", std::move(strat));
+    check(bt.loadTickData(path, "UNZ", filter), "file loads");
+    bt.run();
+    bool same = seen->seen.size() == 100;
+    for (std::size_t i = 0; same && i < seen->seen.size(); ++i) same = seen->seen[i] == ticks[100 + i].timestamp_us;
+    check(same, "filtered load returns the window in order");
+    std::remove(path.c_str());
+}
+
+TEST(backtester_compressed_file_matches_in_memory_series) {
+    const std::string path = "/tmp/algocatalyst_tickblocks_bt.actz";
+    auto ticks = makeWave(600);
+    check(CompressedTickFile::write(path, {{"TZB", ticks}}, 50), "file written");
+
+    // Zero latency fills on the signal tick itself, behind the cursor
+    auto attach = [&](bool from_file) {
+        return [&, from_file](Backtester& bt) {
+            bt.setSlippageBps(5.0);
+            if (from_file) bt.loadTickData(path, "TZB");
+            else bt.addTickSeries("TZB", TickStore::adopt(ticks, internSymbol("TZB")));
+        };
+    };
+    for (double latency_ms : {0.0, 1500.0}) {
+        auto from_memory = meanRevTrades("TZB", attach(false), latency_ms);
+        auto from_file = meanRevTrades("TZB", attach(true), latency_ms);
+        check(!from_memory.empty() && sameTrades(from_memory, from_file),
+              "decoded blocks give the same trades as the tick vector");
+    }
+    std::remove(path.c_str());
+}
+
+TEST(tick_filter_window_and_session) {
+    const std::int64_t day = 1'609'459'200'000'000LL;   // 2021-01-01 00:00 UTC
+    TickFilter filter;
+    check(filter.passesAll() && filter.contains(day), "default filter keeps everything");
+    filter.start_us = day;
+    filter.end_us = day + 2 * TickFilter::kUsPerDay;
+    filter.session_open_utc_s = 13 * 3600 + 30 * 60;
+    filter.session_close_utc_s = 20 * 3600;
+    const std::int64_t open = day + (13 * 3600 + 30 * 60) * 1'000'000LL;
+    const std::int64_t close = day + 20 * 3600 * 1'000'000LL;
+    check(filter.contains(open) && !filter.contains(close) && !filter.contains(day - 1), "session and window bounds");
+    check(filter.nextInside(day) == open && filter.nextInside(close) == open + TickFilter::kUsPerDay,
+          "nextInside jumps to the next session open");
+    check(filter.nextInside(close + TickFilter::kUsPerDay) == filter.end_us, "nextInside stops at the window end");
+    check(filter.insideUntil(open + 5) == close, "insideUntil ends at the session close");
+}
+
+TEST(tick_filter_selects_same_ticks_from_every_format) {
+    // Three days of minute ticks; keep day 2 and day 3 until 18:00, 13:30-20:00 UTC only
+    const std::int64_t day = 1'609'459'200'000'000LL;
+    std::vector<Tick> ticks;
+    for (int i = 0; i < 3 * 1440; ++i) {
+        Tick t{};
+        t.timestamp_us = day + i * 60'000'000LL;
+        t.price = std::round((100.0 + 3.0 * std::sin(i * 0.05) + 0.4 * std::sin(i * 0.9)) * 100.0) / 100.0;
+        t.volume = 1000 + (i % 17) * 50;
+        t.bid_size = t.ask_size = 500;
+        t.high = t.low = t.price;
+        ticks.push_back(t);
+    }
+    TickFilter filter;
+    filter.start_us = day + TickFilter::kUsPerDay;
+    filter.end_us = day + 2 * TickFilter::kUsPerDay + 18 * 3600 * 1'000'000LL;
+    filter.session_open_utc_s = 13 * 3600 + 30 * 60;
+    filter.session_close_utc_s = 20 * 3600;
+    std::vector<Tick> expected;
+    std::copy_if(ticks.begin(), ticks.end(), std::back_inserter(expected),
+                 [&](const Tick& t) { return filter.contains(t.timestamp_us); });
+    check(expected.size() == 390 + 270, "expected subset");
+
+    const std::string csv = "/tmp/algocatalyst_filter_test.csv";
+    const std::string actk = "/tmp/algocatalyst_filter_test.actk";
+    const std::string actz = "/tmp/algocatalyst_filter_test.actz";
+    writeTickCsv(csv, ticks);
+    std::ofstream(csv, std::ios::app) << "1609459200000001,not-a-price,1,1,1\n";   // Outside the window: never parsed past its timestamp
+    check(ColumnarTickFile::write(actk, {{"FLT", ticks}}), "actk written");
+    check(CompressedTickFile::write(actz, {{"FLT", ticks}}, 100), "actz written");
+
+    std::ostringstream captured;
+    std::streambuf* old = std::cerr.rdbuf(captured.rdbuf());
+    TickLoadOptions options;
+    options.filter = filter;
+    auto loaded = TickLoader::loadFromCSV(csv, options);
+    std::cerr.rdbuf(old);
+    bool same_rows = loaded.size() == expected.size();
+    for (std::size_t i = 0; same_rows && i < loaded.size(); ++i) {
+        same_rows = loaded[i].timestamp_us == expected[i].timestamp_us && loaded[i].price == expected[i].price;
+    }
+    check(same_rows, "CSV loader keeps exactly the passing rows");
+    check(loaded.capacity() <= 2 * loaded.size(), "filtered load does not reserve the whole file");
+    check(captured.str().empty(), "rows outside the filter are not validated");
+
+    // Fills 90 s after a signal can land after the session close and must take the next session's open
+    auto attach = [&](const std::string& path) {
+        return [&, path](Backtester& bt) {
+            if (path.empty()) bt.addTickSeries("FLT", TickStore::adopt(expected, internSymbol("FLT")));
+            else bt.loadTickData(path, "FLT", filter);
+        };
+    };
+    auto roundTrips = [&](const std::string& path) {
+        Backtester bt(90'000.0);
+        bt.setVerbose(false);
+        attach(path)(bt);
+        bt.registerStrategy("FLT", std::make_unique<RoundTripStrategy>("FLT"));
+        bt.run();
+        return bt.getTradeLog();
+    };
+    auto reference = meanRevTrades("FLT", attach(""), 90'000.0);
+    auto round_trip_reference = roundTrips("");
+    check(!reference.empty() && !round_trip_reference.empty(), "filtered series trades");
+    for (const std::string& path : {csv, actk, actz}) {
+        check(sameTrades(meanRevTrades("FLT", attach(path), 90'000.0), reference), "same trades from " + path);
+        check(sameTrades(roundTrips(path), round_trip_reference), "same round trips from " + path);
+    }
+
+    TickFilePtr file = ColumnarTickFile::open(actk);
+    auto rows = file ? file->selectRows(file->symbols().front(), filter) : std::vector<RowRange>{};
+    check(rows.size() == 2 && rows[0].end - rows[0].begin == 390 && rows[1].end - rows[1].begin == 270,
+          "one row range per session");
+    TickStore::global().evict(csv, "FLT");
+    std::remove(csv.c_str());
+    std::remove(actk.c_str());
+    std::remove(actz.c_str());
+}
+
+TEST(streaming_reader_matches_loader_and_backtest) {
+    // Runs of three equal timestamps, read in 7-tick chunks so runs straddle chunk boundaries
+    const std::string path = "/tmp/algocatalyst_stream_test.csv";
+    auto wave = makeWave(900);
+    for (std::size_t i = 0; i < wave.size(); ++i) {
+        wave[i].timestamp_us = 1'609'459'200'000'000LL + static_cast<std::int64_t>(i / 3) * 1'000'000LL;
+    }
+    {
+        std::span<const Tick> rows(wave);
+        std::ofstream out(path);
+        out << "Timestamp,Price,Volume,Bid_Size,Ask_Size\n";
+        writeTickRows(out, rows.subspan(0, 101), "\r\n");
+        out << "1609459300000000,abc,1,1,1\n";
+        writeTickRows(out, rows.subspan(101, 300), "\r\n");
+        out << "1609459500000000,1\n";
+        writeTickRows(out, rows.subspan(401), "\r\n");
+        out << "1609460000000000,101.5,10,1,1";   // No trailing newline
+    }
+
+    std::ostringstream loader_warnings;
+    std::streambuf* old = std::cerr.rdbuf(loader_warnings.rdbuf());
+    std::streambuf* old_out = std::cout.rdbuf(nullptr);
+    TickLoadOptions options;
+    options.threads = 1;
+    auto loaded = TickLoader::loadFromCSV(path, options);
+    std::cout.rdbuf(old_out);
+
+    std::ostringstream reader_warnings;
+    std::cerr.rdbuf(reader_warnings.rdbuf());
+    std::vector<Tick> streamed;
+    {
+        StreamingTickReader reader(path, internSymbol("STR"), {}, 7);
+        check(reader.is_open(), "reader opens the file");
+        for (int pass = 0; pass < 2; ++pass) {
+            streamed.clear();
+            while (const Tick* t = reader.peek()) {
+                streamed.push_back(*t);
+                reader.advance();
+            }
+            check(pass == 1 || reader.rewind(), "reader rewinds");
+        }
+    }
+    std::cerr.rdbuf(old);
+    check(loaded.size() == 901 && streamed.size() == loaded.size(), "streamed every loaded tick");
+    bool same = streamed.size() == loaded.size();
+    for (std::size_t i = 0; same && i < loaded.size(); ++i) {
+        same = streamed[i].timestamp_us == loaded[i].timestamp_us && streamed[i].price == loaded[i].price &&
+               streamed[i].volume == loaded[i].volume && streamed[i].high == loaded[i].high;
+    }
+    check(same, "streamed ticks equal loaded ticks");
+    std::string first_pass = reader_warnings.str().substr(0, reader_warnings.str().size() / 2);
+    check(!loader_warnings.str().empty() && first_pass == loader_warnings.str(), "same warnings as the loader");
+
+    // Zero latency fills on the signal tick itself, possibly in a chunk already handed back
+    auto runOn = [&](int mode, double latency_ms) {
+        auto attach = [&](Backtester& bt) {
+            bt.setSlippageBps(5.0);
+            if (mode == 0) bt.addTickSeries("STR", TickStore::adopt(loaded, internSymbol("STR")));
+            else if (mode == 1) bt.streamTickData(path, "STR");
+            else bt.addTickSource("STR", std::make_unique<StreamingTickReader>(path, internSymbol("STR"), TickFilter{}, 7));
+        };
+        std::streambuf* quiet = std::cerr.rdbuf(nullptr);
+        auto trades = meanRevTrades("STR", attach, latency_ms, true);
+        std::cerr.rdbuf(quiet);
+        return trades;
+    };
+    for (double latency_ms : {0.0, 1500.0}) {
+        auto reference = runOn(0, latency_ms);
+        check(!reference.empty(), "in-memory series trades");
+        for (int mode : {1, 2}) {
+            check(sameTrades(runOn(mode, latency_ms), reference),
+                  "streamed run gives the same trades as the tick vector");
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(dataset_index_selects_partitions_and_runs_like_one_series) {
+    // Three days of one symbol in mixed formats, one day of another
+    namespace fs = std::filesystem;
+    const std::string root = "/tmp/algocatalyst_dataset_test";
+    fs::remove_all(root);
+    fs::create_directories(root + "/DSA");
+    fs::create_directories(root + "/DSB");
+    const std::int64_t day = 1'609'459'200'000'000LL;
+    auto ticks = makeWave(600);
+    for (int i = 0; i < 600; ++i) ticks[i].timestamp_us = day + (i / 200) * TickFilter::kUsPerDay + (i % 200) * 1'000'000LL;
+    std::span<const Tick> all(ticks);
+    writeTickCsv(root + "/DSA/2021-01-01.csv", all.subspan(0, 200));
+    check(CompressedTickFile::write(root + "/DSA/2021-01-02.actz", {{"DSA", all.subspan(200, 200)}}, 64), "actz partition");
+    writeTickCsv(root + "/DSA/2021-01-03.csv", all.subspan(400, 200));
+    check(ColumnarTickFile::write(root + "/DSB/2021-01-01.actk", {{"DSB", all.subspan(0, 200)}}), "actk partition");
+
+    std::streambuf* old_out = std::cout.rdbuf(nullptr);
+    bool indexed = Dataset::buildIndex(root);
+    std::cout.rdbuf(old_out);
+    check(indexed, "index built");
+    DatasetPtr dataset = Dataset::open(root);
+    check(dataset && dataset->partitions().size() == 4, "manifest lists every file");
+    if (!dataset) return;
+    check(dataset->symbols() == std::vector<std::string>{"DSA", "DSB"}, "symbols from directories");
+    auto parts = dataset->select("DSA");
+    check(parts.size() == 3 && parts[1]->path == "DSA/2021-01-02.actz" && parts[1]->rows == 200 &&
+              parts[1]->first_timestamp_us == ticks[200].timestamp_us && parts[2]->last_timestamp_us == ticks[599].timestamp_us,
+          "partitions in time order with their ranges");
+    TickFilter filter;
+    filter.start_us = day + TickFilter::kUsPerDay + 50 * 1'000'000LL;
+    check(dataset->select("DSA", filter).size() == 2 && dataset->select("DSB", filter).empty(),
+          "partitions before the window are not selected");
+    check(dataset->verify() == 0, "files match the manifest");
+
+    auto runOn = [&](bool from_dataset, double latency_ms, const TickFilter& f) {
+        return meanRevTrades("DSA", [&](Backtester& bt) {
+            bt.setSlippageBps(5.0);
+            if (from_dataset) {
+                bt.addDataset("DSA", dataset, f);
+            } else {
+                std::vector<Tick> kept;
+                std::copy_if(ticks.begin(), ticks.end(), std::back_inserter(kept),
+                             [&](const Tick& t) { return f.contains(t.timestamp_us); });
+                bt.addTickSeries("DSA", TickStore::adopt(std::move(kept), internSymbol("DSA")));
+            }
+        }, latency_ms);
+    };
+    for (const TickFilter& f : {TickFilter{}, filter}) {
+        for (double latency_ms : {0.0, 1500.0}) {
+            auto reference = runOn(false, latency_ms, f);
+            check(!reference.empty() && sameTrades(runOn(true, latency_ms, f), reference),
+                  "partitions give the same trades as one series");
+        }
+    }
+
+    std::ofstream(root + "/DSA/2021-01-03.csv", std::ios::app) << "1609718400000000,100,1,1,1\n";
+    std::ostringstream captured;
+    std::streambuf* old_err = std::cerr.rdbuf(captured.rdbuf());
+    std::size_t changed = dataset->verify();
+    std::cerr.rdbuf(old_err);
+    check(changed == 1 && captured.str().find("DSA/2021-01-03.csv") != std::string::npos, "verify reports the edited file");
+    fs::remove_all(root);
+}
+
+TEST(tick_cache_reuses_parse_until_source_changes) {
+    const std::string path = "/tmp/algocatalyst_cache_test.csv";
+    const std::string cache = TickCache::pathFor(path);
+    std::remove(cache.c_str());
+    auto wave = makeWave(300);
+    auto writeCsv = [&](double first_price) {
+        wave[0].price = first_price;
+        std::span<const Tick> rows(wave);
+        std::ofstream out(path);
+        out << "Timestamp,Price,Volume,Bid_Size,Ask_Size\n";
+        writeTickRows(out, rows.subspan(0, 11));
+        out << "1609459210500000,abc,1,1,1\n";
+        writeTickRows(out, rows.subspan(11));
+    };
+    writeCsv(101.0);
+
+    // Returns the ticks; 'out' / 'err' get what the load printed
+    auto load = [&](TickCacheMode mode, const TickFilter& filter, std::string& out, std::string& err) {
+        std::ostringstream out_text, err_text;
+        std::streambuf* old_out = std::cout.rdbuf(out_text.rdbuf());
+        std::streambuf* old_err = std::cerr.rdbuf(err_text.rdbuf());
+        TickLoadOptions options;
+        options.cache = mode;
+        options.filter = filter;
+        auto ticks = TickLoader::loadFromCSV(path, options);
+        std::cout.rdbuf(old_out);
+        std::cerr.rdbuf(old_err);
+        out = out_text.str();
+        err = err_text.str();
+        return ticks;
+    };
+    auto sameTicks = [](const std::vector<Tick>& a, const std::vector<Tick>& b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].timestamp_us != b[i].timestamp_us || a[i].price != b[i].price || a[i].volume != b[i].volume ||
+                a[i].high != b[i].high) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::string out, err;
+    load(TickCacheMode::Off, {}, out, err);
+    check(std::ifstream(cache).fail(), "Off writes no cache");
+    auto parsed = load(TickCacheMode::Use, {}, out, err);
+    check(parsed.size() == 300 && out.find("(cached)") == std::string::npos && err.find("[WARN]") != std::string::npos,
+          "first load parses and warns");
+    auto cached = load(TickCacheMode::Use, {}, out, err);
+    check(sameTicks(parsed, cached) && out.find("(cached)") != std::string::npos, "second load reads the cache");
+    check(err.find("[WARN]") == std::string::npos && err.find("Skipped 1 malformed") != std::string::npos,
+          "cache hit keeps the skip count");
+
+    TickFilter filter;
+    filter.start_us = wave[100].timestamp_us;
+    filter.end_us = wave[200].timestamp_us;
+    auto cut = load(TickCacheMode::Use, filter, out, err);
+    auto reparsed = load(TickCacheMode::Off, filter, out, err);
+    check(cut.size() == 100 && sameTicks(cut, reparsed), "filtered load cut from the cache");
+
+    // Same size and mtime but different contents: the content hash catches it
+    struct stat before;
+    ::stat(path.c_str(), &before);
+    writeCsv(102.0);
+    struct timespec times[2] = {before.st_atim, before.st_mtim};
+    ::utimensat(AT_FDCWD, path.c_str(), times, 0);
+    auto changed = load(TickCacheMode::Use, {}, out, err);
+    check(changed.size() == 300 && changed[0].price == 102.0 && out.find("(cached)") == std::string::npos,
+          "changed contents invalidate the cache");
+    load(TickCacheMode::Rebuild, {}, out, err);
+    check(out.find("(cached)") == std::string::npos, "Rebuild always parses");
+    std::remove(path.c_str());
+    std::remove(cache.c_str());
+}
+
+// ── SymbolTable ───────────────────────────────────────────────────────────────
+TEST(symbol_table_interns_dense_stable_ids) {
+    SymbolTable table;
+    SymbolId a = table.intern("AAPL");
+    SymbolId b = table.intern("MSFT");
+    check(a == 0 && b == 1, "IDs are dense in first-seen order");
+    check(table.intern("AAPL") == a, "Re-interning returns the same ID");
+    check(table.name(b) == "MSFT", "name() round-trips");
+    SymbolId found = 99;
+    check(table.find("MSFT", found) && found == b, "find() locates interned ticker");
+    check(!table.find("TSLA", found), "find() misses unknown ticker");
+}
+
+TEST(backtester_routes_large_universe_by_symbol_id) {
+    const int kSymbols = 3000;
+    std::vector<std::vector<Tick>> series;
+    series.reserve(kSymbols);
+    for (int i = 0; i < kSymbols; ++i) series.push_back(makeSeries(1'000'000 + i, 1'000'000, 3));
+
+    Backtester bt(0.0);
+    std::vector<RecordingStrategy*> recorders;
+    for (int i = 0; i < kSymbols; ++i) {
+        std::string sym = "U" + std::to_string(i);
+        auto strat = std::make_unique<RecordingStrategy>(sym);
+        recorders.push_back(strat.get());
+        bt.registerStrategy(sym, std::move(strat));
+        bt.addTickSource(sym, std::make_unique<VectorTickSource>(series[i]));
+    }
+    bt.run();
+
+    for (int i = 0; i < kSymbols; ++i) {
+        check(recorders[i]->seen.size() == 3, "each symbol sees exactly its own ticks");
+        check(recorders[i]->seen.front() == series[i].front().timestamp_us, "first tick matches");
+    }
+}
+
+// ── FillPricer ────────────────────────────────────────────────────────────────
+static const Tick* linearFirstAtOrAfter(const std::vector<Tick>& ticks, std::int64_t ts) {
+    for (const auto& t : ticks) {
+        if (t.timestamp_us >= ts) return &t;
+    }
+    return nullptr;
+}
+
+TEST(fill_pricer_matches_linear_scan_forward) {
+    auto ticks = makeSeries(1'000'000, 100'000, 500);
+    FillPricer pricer(ticks);
+    for (std::int64_t ts = 0; ts < 60'000'000; ts += 37'000) {
+        check(pricer.firstAtOrAfter(ts) == linearFirstAtOrAfter(ticks, ts),
+              "forward query matches linear scan");
+    }
+}
+
+TEST(fill_pricer_handles_out_of_order_queries) {
+    auto ticks = makeSeries(1'000'000, 100'000, 500);
+    FillPricer pricer(ticks);
+    const std::int64_t queries[] = {20'000'000, 5'000'050, 45'000'000, 1'000'000, 999, 30'000'000};
+    for (std::int64_t ts : queries) {
+        check(pricer.firstAtOrAfter(ts) == linearFirstAtOrAfter(ticks, ts),
+              "out-of-order query matches linear scan");
+    }
+}
+
+TEST(fill_pricer_returns_null_past_end) {
+    auto ticks = makeSeries(1'000'000, 100'000, 10);
+    FillPricer pricer(ticks);
+    check(pricer.firstAtOrAfter(1'000'000'000) == nullptr, "no tick after the series ends");
+    check(pricer.firstAtOrAfter(1'000'000) == &ticks.front(), "recovers after past-end query");
+}
@@ -1,5 +1,15 @@
 #include "runner.h"
+#include "BatchIndicators.h"
+#include "FixedIndicators.h"
 #include "Indicators.h"
+#include "RingBuffer.h"
+#include "RollingMinMax.h"
+#include "RollingStats.h"
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
 
 using namespace AlgoCatalyst;
 using namespace TestRunner;
@@ -17,6 +27,44 @@ TEST(ema_converges_on_constant_series) {
     checkClose(ind.getEMA(10), 100.0, 0.001, "EMA of constant series");
 }
 
+TEST(fixed_period_indicators_match_runtime_api) {
+    Indicators ind;
+    EMA<9> ema9;
+    EMA<200> ema200;
+    RSI<14> rsi;
+    ATR<14> atr;
+    DEMA<10> dema;
+    TRIX<15> trix;
+    for (int i = 0; i < 600; ++i) {
+        double close = 100.0 + 8.0 * std::sin(i * 0.03) + (i % 11) * 0.07;
+        double high = close + 0.4, low = close - 0.3;
+        ind.updateEMA(close, 9);
+        ind.updateEMA(close, 200);
+        ind.updateRSI(close, 14);
+        ind.updateATR(high, low, close, 14);
+        ind.updateDEMA(close, 10);
+        ind.updateTRIX(close, 15);
+        ema9.update(close);
+        ema200.update(close);
+        rsi.update(close);
+        atr.update(high, low, close);
+        dema.update(close);
+        trix.update(close);
+        // Same update code: values agree exactly, including during warm-up
+        check(ema9.value() == ind.getEMA(9) && ema200.value() == ind.getEMA(200), "EMA<N> == getEMA(N)");
+        check(rsi.value() == ind.getRSI(14), "RSI<N> == getRSI(N)");
+        check(atr.value() == ind.getATR(14) && atr.percentOf(close) == ind.getATRPercent(close, 14),
+              "ATR<N> == getATR(N)");
+        check(dema.value() == ind.getDEMA(10), "DEMA<N> == getDEMA(N)");
+        check(trix.value() == ind.getTRIX(), "TRIX<N> == getTRIX()");
+    }
+    check(ema200.value() > 0.0 && ema200.isPriceAbove(ema200.value() + 1.0), "EMA<200> warmed up");
+
+    ema200.reset();
+    rsi.reset();
+    check(ema200.value() == 0.0 && rsi.value() == 50.0, "reset returns to warm-up");
+}
+
 // ── RSI ──────────────────────────────────────────────────────────────────────
 TEST(rsi_default_is_neutral_before_warm_up) {
     Indicators ind;
@@ -57,6 +105,126 @@ TEST(bollinger_constant_series_has_zero_bandwidth) {
     checkClose(ind.getBollingerBandwidth(), 0.0, 1e-9, "Zero bandwidth on constant");
 }
 
+TEST(bollinger_long_period_matches_two_pass) {
+    Indicators ind;
+    std::vector<double> prices;
+    for (int i = 0; i < 3000; ++i) {
+        prices.push_back(250.0 + 5.0 * std::sin(i * 0.05) + (i % 7) * 0.01);
+        ind.updateBollingerBands(prices.back(), 500, 2.0);
+    }
+    double mean = 0.0, var = 0.0;
+    for (std::size_t i = prices.size() - 500; i < prices.size(); ++i) mean += prices[i];
+    mean /= 500;
+    for (std::size_t i = prices.size() - 500; i < prices.size(); ++i) var += (prices[i] - mean) * (prices[i] - mean);
+    double sd = std::sqrt(var / 500);
+    checkClose(ind.getBollingerMiddle(), mean, 1e-9, "500-period middle band");
+    checkClose(ind.getBollingerUpper(), mean + 2.0 * sd, 1e-9, "500-period upper band");
+}
+
+// ── RingBuffer ────────────────────────────────────────────────────────────────
+TEST(ring_buffer_slides_a_window_without_reallocating) {
+    RingBuffer<int> ring(20);
+    check(ring.capacity() == 32, "capacity rounds up to a power of two");
+    for (int i = 0; i < 1000; ++i) {
+        ring.push_back(i);
+        if (ring.size() > 20) ring.pop_front();
+    }
+    check(ring.capacity() == 32, "a reserved window never grows");
+    check(ring.size() == 20 && ring.front() == 980 && ring.back() == 999, "window holds the newest values");
+    for (std::size_t i = 0; i < ring.size(); ++i) check(ring[i] == 980 + static_cast<int>(i), "oldest first");
+
+    // Random-access iterators across the wrap point
+    check(ring.end() - ring.begin() == 20, "iterator distance");
+    check(std::accumulate(ring.begin(), ring.end(), 0) == (980 + 999) * 10, "iteration covers the window");
+    check(*(ring.end() - 1) == 999 && ring.begin()[5] == 985, "iterator arithmetic");
+    check(*std::max_element(ring.begin(), ring.end()) == 999, "usable with algorithms");
+
+    ring.pop_back();
+    check(ring.back() == 998, "pop_back removes the newest");
+
+    RingBuffer<int> copy = ring;
+    ring.clear();
+    check(ring.empty() && copy.size() == 19 && copy.front() == 980, "copies are independent");
+
+    RingBuffer<int> grown;
+    for (int i = 0; i < 100; ++i) grown.push_back(i);
+    check(grown.size() == 100 && grown[0] == 0 && grown[99] == 99, "an unreserved buffer grows in order");
+
+    RingBuffer<int> wrapped(8);
+    for (int i = 0; i < 8; ++i) wrapped.push_back(i);
+    for (int i = 0; i < 3; ++i) wrapped.pop_front();
+    for (int i = 8; i < 20; ++i) wrapped.push_back(i);
+    check(wrapped.size() == 17 && wrapped.front() == 3 && wrapped.back() == 19 && wrapped[7] == 10,
+          "growing a wrapped buffer keeps its order");
+}
+
+// ── RollingStats ──────────────────────────────────────────────────────────────
+TEST(rolling_stats_match_two_pass_on_offset_series) {
+    // Prices near 1e6 with small moves: the case where naive sum-of-squares variance fails
+    RollingStats stats(200);
+    std::vector<double> values;
+    std::uint64_t seed = 42;
+    for (int i = 0; i < 50000; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        values.push_back(1e6 + static_cast<double>(seed >> 40) / (1 << 24));
+        stats.push(values.back());
+        if (i % 997 != 0 || i < 200) continue;
+
+        double mean = 0.0, var = 0.0;
+        for (std::size_t j = values.size() - 200; j < values.size(); ++j) mean += values[j];
+        mean /= 200;
+        for (std::size_t j = values.size() - 200; j < values.size(); ++j) var += (values[j] - mean) * (values[j] - mean);
+        var /= 200;
+        checkClose(stats.mean(), mean, 1e-7, "rolling mean");
+        checkClose(stats.variance(), var, 1e-9, "rolling variance");
+    }
+    check(stats.full() && stats.size() == 200, "window holds the period");
+
+    stats.setPeriod(10);
+    double mean = 0.0;
+    for (std::size_t j = values.size() - 10; j < values.size(); ++j) mean += values[j];
+    checkClose(stats.mean(), mean / 10, 1e-7, "shrinking keeps the newest values");
+    stats.clear();
+    check(stats.empty() && stats.sum() == 0.0 && stats.variance() == 0.0, "clear empties the window");
+}
+
+TEST(stochastic_d_averages_last_k_values) {
+    Indicators ind;
+    std::vector<double> ks;
+    for (int i = 0; i < 40; ++i) {
+        double close = 100.0 + 3.0 * std::sin(i * 0.7);
+        ind.updateStochastic(close + 1.0, close - 1.0, close, 5, 3);
+        if (i >= 4) ks.push_back(ind.getStochasticK());
+    }
+    double d = (ks[ks.size() - 1] + ks[ks.size() - 2] + ks[ks.size() - 3]) / 3.0;
+    checkClose(ind.getStochasticD(), d, 1e-9, "%D is the mean of the last three %K");
+}
+
+TEST(cmf_and_mfi_match_window_sums) {
+    Indicators ind;
+    std::vector<double> mfv, vol, pos, neg;
+    double prev_tp = 0.0;
+    for (int i = 0; i < 60; ++i) {
+        double close = 50.0 + 2.0 * std::sin(i * 0.4), high = close + 0.5 + (i % 3) * 0.1, low = close - 0.7;
+        std::int64_t volume = 100 + (i * 37) % 400;
+        ind.updateCMF(high, low, close, volume, 20);
+        ind.updateMFI(high, low, close, volume, 14);
+        mfv.push_back(((close - low) - (high - close)) / (high - low) * volume);
+        vol.push_back(static_cast<double>(volume));
+        double tp = (high + low + close) / 3.0;
+        if (prev_tp > 0.0) {
+            pos.push_back(tp >= prev_tp ? tp * volume : 0.0);
+            neg.push_back(tp >= prev_tp ? 0.0 : tp * volume);
+        }
+        prev_tp = tp;
+    }
+    double sum_mfv = 0.0, sum_vol = 0.0, sum_pos = 0.0, sum_neg = 0.0;
+    for (std::size_t j = mfv.size() - 20; j < mfv.size(); ++j) { sum_mfv += mfv[j]; sum_vol += vol[j]; }
+    for (std::size_t j = pos.size() - 14; j < pos.size(); ++j) { sum_pos += pos[j]; sum_neg += neg[j]; }
+    checkClose(ind.getCMF(), sum_mfv / sum_vol, 1e-9, "CMF over the last 20 bars");
+    checkClose(ind.getMFI(), 100.0 - 100.0 / (1.0 + sum_pos / sum_neg), 1e-9, "MFI over the last 14 bars");
+}
+
 // ── WMA ──────────────────────────────────────────────────────────────────────
 TEST(wma_returns_zero_before_period) {
     Indicators ind;
@@ -90,6 +258,56 @@ TEST(donchian_lower_is_min_of_period) {
     checkClose(ind.getDonchianLower(), 80.0, 0.01, "Donchian lower = lowest low");
 }
 
+TEST(donchian_day_range_matches_scan) {
+    Indicators ind;
+    std::vector<double> highs, lows;
+    for (int i = 0; i < 2000; ++i) {
+        double mid = 100.0 + 10.0 * std::sin(i * 0.013) + (i * 7919 % 13) * 0.05;
+        highs.push_back(mid + 0.2);
+        lows.push_back(mid - 0.3);
+        ind.updateDonchian(highs.back(), lows.back(), 390);
+    }
+    double upper = *std::max_element(highs.end() - 390, highs.end());
+    double lower = *std::min_element(lows.end() - 390, lows.end());
+    check(ind.getDonchianUpper() == upper, "390-tick upper = highest high");
+    check(ind.getDonchianLower() == lower, "390-tick lower = lowest low");
+}
+
+// ── RollingMinMax ─────────────────────────────────────────────────────────────
+TEST(rolling_min_max_matches_scan) {
+    // 64 fills the ring exactly; 1 and 390 cover the other edges
+    for (std::size_t period : {std::size_t{1}, std::size_t{64}, std::size_t{390}}) {
+        RollingMinMax window(period);
+        std::vector<double> values;
+        std::uint64_t seed = period;
+        for (int i = 0; i < 5000; ++i) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            // Few distinct values, so ties are common
+            values.push_back(static_cast<double>((seed >> 33) % 50));
+            window.push(values.back());
+            std::size_t n = std::min(values.size(), period);
+            check(window.size() == n, "window size");
+            check(window.max() == *std::max_element(values.end() - n, values.end()), "window max");
+            check(window.min() == *std::min_element(values.end() - n, values.end()), "window min");
+        }
+        check(window.full(), "window is full");
+    }
+
+    // A falling series keeps every value in the max deque: the ring must hold a full window
+    RollingMinMax falling(64);
+    for (int i = 0; i < 200; ++i) falling.push(1000.0 - i);
+    check(falling.max() == 1000.0 - 136 && falling.min() == 1000.0 - 199, "falling series extremes");
+
+    RollingMinMax window(5);
+    for (double v : {9.0, 1.0, 5.0, 4.0, 3.0}) window.push(v + 1.0, v);
+    window.setPeriod(3);
+    check(window.max() == 6.0 && window.min() == 3.0, "shrinking keeps the newest pairs");
+    window.setPeriod(4);
+    check(!window.full() && window.size() == 3, "growing waits for more pairs");
+    window.clear();
+    check(window.empty() && window.max() == 0.0, "clear empties the window");
+}
+
 // ── CCI ───────────────────────────────────────────────────────────────────────
 TEST(cci_zero_on_constant_series) {
     Indicators ind;
@@ -119,6 +337,15 @@ TEST(obv_decreases_on_down_tick) {
     check(ind.getOBV() < 0.0, "OBV negative after down tick");
 }
 
+TEST(obv_ema_tracks_obv_after_warm_up) {
+    Indicators ind;
+    for (int i = 0; i < 5; ++i) ind.updateOBV(100.0 + i, 1000, 10);
+    check(ind.getOBVEMA() == ind.getOBV(), "OBV EMA is OBV itself before warm-up");
+    for (int i = 0; i < 300; ++i) ind.updateOBV(100.0 + (i % 2), 1000, 10);
+    // OBV now alternates between 3000 and 4000
+    check(ind.getOBVEMA() > 3000.0 && ind.getOBVEMA() < 4000.0, "OBV EMA settles between the swings");
+}
+
 // ── Williams %R ───────────────────────────────────────────────────────────────
 TEST(williams_r_range) {
     Indicators ind;
@@ -139,3 +366,145 @@ TEST(reset_clears_all_state) {
     check(ind.getEMA(10) == 0.0, "EMA cleared after reset");
     check(ind.getRSI(14) == 50.0, "RSI neutral after reset");
 }
+
+// ── Batch ─────────────────────────────────────────────────────────────────────
+namespace {
+
+// Random walk with some high/low spread; long enough for several Bollinger
+// blocks and an odd length so the vector kernels have a scalar tail
+struct Bars {
+    std::vector<double> high, low, close;
+};
+
+Bars randomBars(std::size_t n) {
+    Bars bars;
+    std::uint64_t seed = 42;
+    double price = 100.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        price += (static_cast<double>((seed >> 33) % 2001) - 1000.0) * 1e-4;
+        double spread = static_cast<double>((seed >> 20) % 100) * 1e-3;
+        bars.close.push_back(price);
+        bars.high.push_back(price + spread);
+        bars.low.push_back(price - spread);
+    }
+    return bars;
+}
+
+void checkRelative(double got, double expected, const std::string& msg) {
+    checkClose(got, expected, 1e-10 * std::max(1.0, std::abs(expected)), msg);
+}
+
+// Runs fn once with the AVX2 kernels (if the CPU has them) and once without
+template <typename Fn>
+void withAndWithoutSimd(Fn fn) {
+    bool was_enabled = BatchIndicators::simdEnabled();
+    for (bool simd : {true, false}) {
+        BatchIndicators::setSimdEnabled(simd);
+        try {
+            fn();
+        } catch (...) {
+            BatchIndicators::setSimdEnabled(was_enabled);
+            throw;
+        }
+    }
+    BatchIndicators::setSimdEnabled(was_enabled);
+}
+
+} // namespace
+
+TEST(batch_ema_and_rsi_match_streaming) {
+    withAndWithoutSimd([] {
+        for (std::size_t n : {std::size_t{3}, std::size_t{20}, std::size_t{10'007}}) {
+            Bars bars = randomBars(n);
+            for (std::size_t period : {std::size_t{1}, std::size_t{14}, std::size_t{20}}) {
+                std::vector<double> ema(n), rsi(n);
+                BatchIndicators::ema(bars.close, period, ema);
+                BatchIndicators::rsi(bars.close, period, rsi);
+                Indicators ind;
+                for (std::size_t i = 0; i < n; ++i) {
+                    ind.updateEMA(bars.close[i], period);
+                    ind.updateRSI(bars.close[i], period);
+                    checkRelative(ema[i], ind.getEMA(period), "batch EMA");
+                    checkRelative(rsi[i], ind.getRSI(period), "batch RSI");
+                }
+            }
+        }
+    });
+}
+
+TEST(batch_atr_and_macd_match_streaming) {
+    withAndWithoutSimd([] {
+        for (std::size_t n : {std::size_t{10}, std::size_t{26}, std::size_t{10'007}}) {
+            Bars bars = randomBars(n);
+            std::vector<double> atr(n), macd(n), signal(n), histogram(n);
+            BatchIndicators::atr(bars.high, bars.low, bars.close, 14, atr);
+            BatchIndicators::macd(bars.close, macd, signal, histogram);
+            Indicators ind;
+            for (std::size_t i = 0; i < n; ++i) {
+                ind.updateATR(bars.high[i], bars.low[i], bars.close[i], 14);
+                ind.updateMACD(bars.close[i]);
+                checkRelative(atr[i], ind.getATR(14), "batch ATR");
+                checkRelative(macd[i], ind.getMACD(), "batch MACD");
+                checkRelative(signal[i], ind.getMACDSignal(), "batch MACD signal");
+                checkRelative(histogram[i], ind.getMACDHistogram(), "batch MACD histogram");
+            }
+        }
+    });
+}
+
+TEST(batch_bollinger_matches_streaming) {
+    withAndWithoutSimd([] {
+        // 5000 covers a window longer than one block
+        for (std::size_t period : {std::size_t{1}, std::size_t{20}, std::size_t{5000}}) {
+            std::size_t n = 10'007;
+            Bars bars = randomBars(n);
+            std::vector<double> upper(n), middle(n), lower(n);
+            BatchIndicators::bollinger(bars.close, period, 2.0, upper, middle, lower);
+            Indicators ind;
+            for (std::size_t i = 0; i < n; ++i) {
+                ind.updateBollingerBands(bars.close[i], period, 2.0);
+                checkRelative(upper[i], ind.getBollingerUpper(), "batch Bollinger upper");
+                checkRelative(middle[i], ind.getBollingerMiddle(), "batch Bollinger middle");
+                checkRelative(lower[i], ind.getBollingerLower(), "batch Bollinger lower");
+            }
+        }
+    });
+}
+
+TEST(batch_bollinger_collapses_on_flat_prices) {
+    withAndWithoutSimd([] {
+        // Moves, then sits still for longer than the window
+        std::vector<double> prices = randomBars(3000).close;
+        prices.insert(prices.end(), 100, prices.back());
+        std::size_t n = prices.size();
+        std::vector<double> upper(n), middle(n), lower(n);
+        BatchIndicators::bollinger(prices, 20, 2.0, upper, middle, lower);
+        for (std::size_t i = n - 80; i < n; ++i) {
+            check(upper[i] == lower[i], "no band width over a flat window");
+            checkRelative(middle[i], prices.back(), "middle band is the flat price");
+        }
+    });
+}
+
+TEST(batch_rejects_short_outputs_and_zero_period) {
+    std::vector<double> prices(30, 100.0), out(29), full(30);
+    auto throws = [](auto fn) {
+        try {
+            fn();
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    check(throws([&] { BatchIndicators::ema(prices, 10, out); }), "short EMA output rejected");
+    check(throws([&] { BatchIndicators::rsi(prices, 0, full); }), "zero RSI period rejected");
+    check(throws([&] { BatchIndicators::atr(prices, prices, prices, 14, out); }), "short ATR output rejected");
+    check(throws([&] { BatchIndicators::bollinger(prices, 20, 2.0, full, out, full); }),
+          "short Bollinger output rejected");
+    check(throws([&] { BatchIndicators::macd(prices, full, full, out); }), "short MACD output rejected");
+
+    std::vector<double> empty;
+    BatchIndicators::ema(empty, 10, empty);
+    BatchIndicators::bollinger(empty, 20, 2.0, empty, empty, empty);
+}